@@ -1,16 +1,88 @@
 #pragma once
 
-//header-only library for testing C++ standard library components
+//header-only library for testing C++ standard library components (requires C++20)
 
+#include <algorithm>
+#include <functional>
+#include <type_traits>
 #include <ostream>
 #include <random>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <cstring>
 #include <iterator>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <forward_list>
 #include <set>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <bit>
+#include <atomic>
+#include <thread>
+#include <concepts>
+#include <exception>
+
+#include <span>
+#include <chrono>
+#include <iomanip>
+#include <ranges>
+#include <tuple>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <numeric>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <variant>
+#include <initializer_list>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(_MSC_VER)
+#include <x86intrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 
 std::ostream& dash_line(std::ostream& os);
@@ -53,6 +125,18 @@ std::ostream& operator<<(std::ostream& os, const std::pair<T, U>& p)
  * generated by a random function. Elements are inserted into the container until its size
  * reaches the desired number.
  *
+ * The fastest fill path of the container is selected at compile time:
+ * - contiguous containers filled by a generator having a bulk `generate(pointer, count)` member
+ *   (`Irand`, `Drand`) are resized once and filled by a single call of that member,
+ * - sequence containers that can be resized (`std::vector`, `std::string`, `std::deque`, ...)
+ *   are grown once and the new elements are generated in a single pass directly into the
+ *   container's storage (no reallocation, no per-element `insert`),
+ * - containers having `reserve()` (e.g. unordered containers) reserve their capacity first,
+ * - all other containers (`std::set`, `std::map`, ...) use hinted insertion at `end()`.
+ *
+ * For associative containers with unique keys the loop keeps running until `n` distinct
+ * elements are present, so `frand` must be able to produce at least `n` different values.
+ *
  * @tparam Collection The type of the container to be filled. The container must support
  *         the `size()`, `insert()`, and `end()` member functions.
  * @tparam Random The type of the random function, which must be callable with no arguments
@@ -73,18 +157,74 @@ std::ostream& operator<<(std::ostream& os, const std::pair<T, U>& p)
 template<typename Collection, typename Random>
 void rfill(Collection& c, size_t n, Random frand)
 {
-	while (c.size() < n)
-		c.insert(c.end(), frand());
+	const std::size_t old_size = c.size();
+	if (old_size >= n)
+		return;
+
+	if constexpr (requires { c.resize(n); frand.generate(c.data(), n); }) {
+		c.resize(n);
+		frand.generate(c.data() + old_size, n - old_size);
+	}
+	else if constexpr (requires { c.resize(n); } && std::is_default_constructible_v<typename Collection::value_type>) {
+		c.resize(n);
+		std::generate(std::next(c.begin(), old_size), c.end(), std::ref(frand));
+	}
+	else {
+		if constexpr (requires { c.reserve(n); })
+			c.reserve(n);
+
+		while (c.size() < n)
+			c.insert(c.end(), frand());
+	}
 }
 
 //--------------------------------------------------
 //--------------------------------------------------
 
-template<typename T, typename F>
-void rfill(std::forward_list<T>& c, std::size_t n, F frand)
+/**
+ * @brief Fills a `std::forward_list` with `n` randomly generated elements.
+ *
+ * The new elements are chained with `insert_after` behind the previously inserted one,
+ * so they appear in the list in the order they were generated.
+ *
+ * @param c The list to which the new elements are prepended.
+ * @param n The number of elements to be generated.
+ * @param frand The random function used to generate the elements.
+ */
+
+template<typename T, typename A, typename F>
+void rfill(std::forward_list<T, A>& c, std::size_t n, F frand)
 {
+	auto iter = c.before_begin();
 	while (n--)
-		c.insert_after(c.before_begin(), frand());
+		iter = c.insert_after(iter, frand());
+}
+
+
+//--------------------------------------------------
+//--------------------------------------------------
+
+/**
+ * @brief Fills a container with elements generated by `frand` from an explicit engine.
+ *
+ * Same as the three parameter `rfill`, but every element is generated by calling `frand(eng)`,
+ * so the fill can be templated on any engine (`xoshiro256ss`, `pcg64`, `std::mt19937_64`, ...).
+ *
+ * @tparam URBG A type satisfying the UniformRandomBitGenerator requirements.
+ * @param eng The engine passed to `frand` for every element.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * wyrand eng{ 12345 };
+ * rfill(ivec, 1'000'000, Irand{ 0, 1000 }, eng);
+ * @endcode
+ */
+
+template<typename Collection, typename Random, typename URBG>
+void rfill(Collection& c, std::size_t n, Random frand, URBG& eng)
+{
+	rfill(c, n, [&] { return frand(eng); });
 }
 
 
@@ -154,468 +294,7486 @@ void print(InIter beg, InIter end, const char* psep = " ", std::ostream& os = st
 	os << dash_line;
 }
 
+//------------------------------------------------------
+//------------------------------------------------------
 
-//--------------------------------------------------
-//--------------------------------------------------
+namespace detail {
 
-template<typename C, typename F>
-void fcs(C& c, std::size_t n, F func)
-{
-	std::set<typename C::value_type> s;
-	while (s.size() != n)
-		s.insert(func());
-	c.assign(s.begin(), s.end());
+	/**
+	 * @brief Formats values into a fixed stack buffer and writes it to the stream buffer in large blocks.
+	 *
+	 * Arithmetic values are formatted with `std::to_chars`, honoring the base, `boolalpha`,
+	 * floating-point notation and precision settings of the stream; other formatting flags
+	 * (width, fill, showpos, ...) are ignored. Values of other types are inserted with `operator<<`
+	 * after the buffer has been flushed.
+	 */
+	class stream_writer {
+	public:
+		explicit stream_writer(std::ostream& os) : m_os{ os } {}
+
+		stream_writer(const stream_writer&) = delete;
+		stream_writer& operator=(const stream_writer&) = delete;
+
+		~stream_writer()
+		{
+			flush();
+		}
+
+		void write(std::string_view sv)
+		{
+			if (sv.size() > capacity - m_len) {
+				flush();
+				if (sv.size() > capacity) {
+					put_block(sv.data(), sv.size());
+					return;
+				}
+			}
+			std::memcpy(m_buf + m_len, sv.data(), sv.size());
+			m_len += sv.size();
+		}
+
+		template<typename T>
+		void write_value(const T& val)
+		{
+			using type = std::remove_cv_t<T>;
+
+			if constexpr (std::is_same_v<type, bool>) {
+				if (m_os.flags() & std::ios_base::boolalpha)
+					write(val ? "true" : "false");
+				else
+					write(val ? "1" : "0");
+			}
+			else if constexpr (std::is_same_v<type, char> || std::is_same_v<type, signed char> || std::is_same_v<type, unsigned char>) {
+				const char ch = static_cast<char>(val);
+				write(std::string_view{ &ch, 1 });
+			}
+			else if constexpr (std::is_integral_v<type>) {
+				reserve(max_number_length);
+				const auto base = m_os.flags() & std::ios_base::basefield;
+				const int radix = base == std::ios_base::hex ? 16 : base == std::ios_base::oct ? 8 : 10;
+				if (radix == 10) //like operator<<, non-decimal output shows the bit pattern of negative values
+					m_len = std::to_chars(m_buf + m_len, m_buf + capacity, val).ptr - m_buf;
+				else
+					m_len = std::to_chars(m_buf + m_len, m_buf + capacity, static_cast<std::make_unsigned_t<type>>(val), radix).ptr - m_buf;
+			}
+			else if constexpr (std::is_floating_point_v<type>) {
+				reserve(max_number_length);
+				const auto field = m_os.flags() & std::ios_base::floatfield;
+				if (field == (std::ios_base::fixed | std::ios_base::scientific)) { //std::hexfloat, to_chars has no "0x" prefix
+					flush();
+					m_os << val;
+					return;
+				}
+				const auto prec = static_cast<int>(m_os.precision());
+				auto first = m_buf + m_len, last = m_buf + capacity;
+				std::to_chars_result res;
+				if (field == std::ios_base::fixed)
+					res = std::to_chars(first, last, val, std::chars_format::fixed, prec);
+				else if (field == std::ios_base::scientific)
+					res = std::to_chars(first, last, val, std::chars_format::scientific, prec);
+				else
+					res = std::to_chars(first, last, val, std::chars_format::general, prec);
+				if (res.ec == std::errc{})
+					m_len = res.ptr - m_buf;
+				else { //does not fit into the buffer (e.g. huge values with std::fixed)
+					flush();
+					m_os << val;
+				}
+			}
+			else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+				write(std::string_view{ val });
+			}
+			else {
+				flush();
+				m_os << val;
+			}
+		}
+
+		void flush()
+		{
+			if (m_len) {
+				put_block(m_buf, m_len);
+				m_len = 0;
+			}
+		}
+
+	private:
+		static constexpr std::size_t capacity = 16 * 1024;
+		static constexpr std::size_t max_number_length = 512; //enough for any integer and default formatted floating-point value
+
+		void reserve(std::size_t len)
+		{
+			if (capacity - m_len < len)
+				flush();
+		}
+
+		void put_block(const char* p, std::size_t len)
+		{
+			if (m_os.rdbuf()->sputn(p, static_cast<std::streamsize>(len)) != static_cast<std::streamsize>(len))
+				m_os.setstate(std::ios_base::badbit);
+		}
+
+		std::ostream& m_os;
+		std::size_t m_len = 0;
+		char m_buf[capacity];
+	};
+
+	/**
+	 * @brief Turns off the synchronization of the standard streams with C stdio for its lifetime.
+	 */
+	class stdio_unsync_guard {
+	public:
+		explicit stdio_unsync_guard(bool active) : m_active{ active }
+		{
+			if (m_active)
+				m_prev = std::ios_base::sync_with_stdio(false);
+		}
+
+		stdio_unsync_guard(const stdio_unsync_guard&) = delete;
+		stdio_unsync_guard& operator=(const stdio_unsync_guard&) = delete;
+
+		~stdio_unsync_guard()
+		{
+			if (m_active)
+				std::ios_base::sync_with_stdio(m_prev);
+		}
+
+	private:
+		bool m_active;
+		bool m_prev = true;
+	};
 }
-//--------------------------------------------------
-//--------------------------------------------------
 
 /**
-     * @brief Provides access to the underlying random number generator.
-     *
-     * This function returns a reference to a static Mersenne Twister engine,
-     * ensuring that the generator is only seeded once per application run.
-     *
-     * @return A reference to a `std::mt19937` random number generator.
-     */
+ * @brief Fast version of `print` for large ranges.
+ *
+ * Produces the same output as `print(beg, end, psep, os)`, but arithmetic and string elements are
+ * formatted with `std::to_chars` into a reusable stack buffer, which is written to `os.rdbuf()`
+ * with `sputn` in large blocks. This avoids the sentry and locale work of one `operator<<` per
+ * element. Elements of other types fall back to `operator<<`.
+ *
+ * @note Only the base, `boolalpha`, floating-point notation and precision flags of `os` are honored.
+ *
+ * @param beg The beginning input iterator of the range to be printed.
+ * @param end The ending input iterator of the range to be printed.
+ * @param psep A C-string used as a delimiter between the elements in the output stream.
+ * @param os The output stream to which the elements and the dash line will be printed.
+ * @param unsync_stdio If `true`, `std::ios_base::sync_with_stdio(false)` is in effect while printing.
+ *        Whether this has an effect after other I/O has been done is implementation-defined.
+ */
 
-inline [[nodiscard]] std::mt19937& urng()
+template<typename InIter>
+void print_fast(InIter beg, InIter end, const char* psep = " ", std::ostream& os = std::cout, bool unsync_stdio = false)
 {
-    static std::mt19937 eng{ std::random_device{}() };
-    return eng;
+	detail::stdio_unsync_guard guard{ unsync_stdio };
+	if (std::ostream::sentry sentry{ os }; sentry) {
+		detail::stream_writer writer{ os };
+		const std::string_view sep{ psep };
+		while (beg != end) {
+			writer.write_value(*beg++);
+			writer.write(sep);
+		}
+	}
+	os << dash_line;
 }
 
-
 //------------------------------------------------------
 //------------------------------------------------------
 
-
 /**
- * @class Irand
- * @brief A class for generating random integers within a specified range.
+ * @brief Fast version of `print` for large containers.
  *
- * The `Irand` class encapsulates a random number generator that produces
- * integers within a specified range using the Mersenne Twister engine.
+ * See the iterator overload of `print_fast`.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * rfill(ivec, 10'000'000, Irand{ 0, 1'000'000 });
+ * print_fast(ivec, "\n", std::cout, true);
+ * @endcode
  */
 
-class Irand {
-public:
-    /**
-     * @brief Default constructor for the `Irand` class.
-     *
-     * Constructs an `Irand` object without initializing the distribution range.
-     */
-    Irand() = default;
+template<typename Collection>
+void print_fast(const Collection& c, const char* psep = " ", std::ostream& os = std::cout, bool unsync_stdio = false)
+{
+	print_fast(std::begin(c), std::end(c), psep, os, unsync_stdio);
+}
 
-    /**
-     * @brief Constructs an `Irand` object with a specified range.
-     *
-     * @param min The lower bound (inclusive) of the range.
-     * @param max The upper bound (inclusive) of the range.
-     *
-     * Initializes the random number generator to produce values in the range [min, max].
-     */
-    Irand(int min, int max) : m_dist{ min, max } {}
+//------------------------------------------------------
+//------------------------------------------------------
 
-    
+namespace detail {
 
-    /**
-     * @brief Generates a random integer within the specified range.
-     *
-     * This function overloads the function call operator to produce a random integer
-     * within the range [min, max] specified during the construction of the `Irand` object.
-     *
-     * @return A random integer within the range [min, max].
-     */
-    [[nodiscard]] int operator()()
-    {
-        return m_dist(urng());
-    }
+	template<typename T>
+	concept tuple_like = !std::ranges::range<T> && requires { std::tuple_size<T>::value; };
 
-private:
-    std::uniform_int_distribution<int> m_dist;  /**< The distribution used to generate random integers within a specified range. */
-};
+	template<typename T>
+	struct is_optional : std::false_type {};
 
+	template<typename T>
+	struct is_optional<std::optional<T>> : std::true_type {};
 
-//------------------------------------------------------
-//------------------------------------------------------
+	template<typename T>
+	struct is_variant : std::false_type {};
 
-/**
- * @brief A class for generating random double-precision floating-point numbers within a specified range.
- *
- * The `Drand` class provides functionality to generate random `double` values uniformly distributed
- * within a given range [dmin, dmax]. The range is specified during object construction.
- */
-class Drand {
-public:
-	/**
-	 * @brief Default constructor.
-	 *
-	 * Constructs a `Drand` object without initializing the distribution range.
-	 * The range must be specified before using the object to generate random numbers.
-	 */
-	Drand() = default;
+	template<typename... Ts>
+	struct is_variant<std::variant<Ts...>> : std::true_type {};
 
-	/**
-	 * @brief Constructs a `Drand` object with a specified range.
-	 *
-	 * Initializes the random number generator to produce double-precision floating-point numbers
-	 * within the range [dmin, dmax].
-	 *
-	 * @param dmin The minimum value of the range.
-	 * @param dmax The maximum value of the range.
-	 */
-	Drand(double dmin, double dmax) : m_dist{ dmin, dmax } {}
+	template<typename T>
+	concept streamable = requires(std::ostream & os, const T & val) { os << val; };
 
 	/**
-	 * @brief Generates a random double within the specified range.
-	 *
-	 * Returns a random double value uniformly distributed within the range [dmin, dmax]
-	 * specified during the construction of the `Drand` object.
-	 *
-	 * @return A random double value within the range [dmin, dmax].
+	 * @brief Appends the text of `val` to `out`, descending into ranges, tuples, optionals and variants.
 	 *
-	 * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+	 * The kind of every level is selected at compile time, so no stream is involved except for
+	 * types that are only printable with `operator<<`.
 	 */
-	[[nodiscard]] double operator()()
+	template<typename T>
+	void format_append(std::string& out, const T& val)
 	{
-		return m_dist(urng());
+		if constexpr (std::is_same_v<T, bool>) {
+			out += val ? "true" : "false";
+		}
+		else if constexpr (std::is_same_v<T, char>) {
+			out += val;
+		}
+		else if constexpr (std::is_arithmetic_v<T>) {
+			char buf[64];
+			out.append(buf, std::to_chars(buf, buf + sizeof buf, val).ptr);
+		}
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+			out += std::string_view{ val };
+		}
+		else if constexpr (std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, std::monostate>) {
+			out += "null";
+		}
+		else if constexpr (std::ranges::input_range<const T>) {
+			using value_type = std::ranges::range_value_t<const T>;
+			constexpr bool proxy = !std::is_reference_v<std::ranges::range_reference_t<const T>>;
+			out += '{';
+			bool first = true;
+			for (auto&& elem : val) {
+				if (!first)
+					out += ", ";
+				first = false;
+				if constexpr (proxy)
+					format_append(out, static_cast<value_type>(elem)); //e.g. std::vector<bool>
+				else
+					format_append(out, elem);
+			}
+			out += '}';
+		}
+		else if constexpr (tuple_like<T>) {
+			out += '[';
+			[&]<std::size_t... I>(std::index_sequence<I...>) {
+				((out += I ? ", " : "", format_append(out, std::get<I>(val))), ...);
+			}(std::make_index_sequence<std::tuple_size_v<T>>{});
+			out += ']';
+		}
+		else if constexpr (is_optional<T>::value) {
+			if (val)
+				format_append(out, *val);
+			else
+				out += "nullopt";
+		}
+		else if constexpr (is_variant<T>::value) {
+			if (val.valueless_by_exception())
+				out += "valueless";
+			else
+				std::visit([&](const auto& alt) { format_append(out, alt); }, val);
+		}
+		else {
+			static_assert(streamable<T>, "the type cannot be formatted");
+			std::ostringstream oss;
+			oss << val;
+			out += oss.view();
+		}
 	}
+}
 
-private:
-	std::uniform_real_distribution<double> m_dist;  ///< Distribution for generating random doubles in the specified range.
-};
-//------------------------------------------------------
-//------------------------------------------------------
 /**
- * @brief Generates a random name from a predefined list of names.
- *
- * This inline function returns a randomly selected name from a predefined list of names.
- * The names are stored in a static array, and a random index is used to select one name.
+ * @brief Appends the text of a value to a string, composing nested types recursively.
  *
- * @return A `std::string` containing the randomly selected name.
+ * - integers and floating-point values: `std::to_chars` (shortest representation)
+ * - `bool`: `true` / `false`, `char`: the character itself, strings: the characters
+ * - ranges (containers, views, arrays): `{e1, e2, ...}`
+ * - pairs and tuples: `[e1, e2, ...]` like the `operator<<` for `std::pair`
+ * - `std::optional`: the value or `nullopt`, `std::variant`: the active alternative
+ * - anything else: `operator<<` into a string stream
  *
- * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+ * @param out The string the text is appended to. Reusing it avoids allocations.
+ * @param val The value to be formatted.
  *
  * @example
  * @code
- * std::string name = random_name(); // Generates a random name from the list.
- * std::cout << "Random Name: " << name << std::endl;
+ * std::map<int, std::vector<std::pair<std::string, double>>> m{ { 1, { { "ali", 1.5 }, { "can", 2. } } } };
+ * std::string s;
+ * format_into(s, m); // {[1, {[ali, 1.5], [can, 2]}]}
  * @endcode
  */
-inline [[nodiscard]] std::string random_name()
+template<typename T>
+void format_into(std::string& out, const T& val)
 {
-	static constexpr const char* pnames[] = {
-		"abdi", "abdullah", "abdulmuttalip", "adem", "adnan", "afacan", "agah", "ahmet", "akin", "alev",
-		"ali", "alican", "alparslan", "anil", "arda", "asim", "askin", "aslican", "aslihan", "ata",
-		"atakan", "atalay", "atif", "atil", "aycan", "aydan", "aykut", "ayla", "aylin", "aynur",
-		"ayse", "aytac", "aziz", "azize", "azmi", "baran", "bekir", "belgin", "bennur", "beril",
-		"berivan", "berk", "beste", "beyhan", "bilal", "bilge", "bilgin", "billur", "binnaz", "binnur",
-		"birhan", "bora", "bulent", "burak", "burhan", "busra", "cahide", "cahit", "can", "canan",
-		"candan", "caner", "tamer", "cansu", "cebrail", "celal", "celik", "cem", "cemal", "cemil", "cemile",
-		"cemre", "cengiz", "cesim", "cetin", "ceyda", "ceyhan", "ceyhun", "ceylan", "cezmi", "cihan",
-		"cihat", "ciler", "cumhur", "cuneyt", "demet", "demir", "deniz", "derin", "derya", "devlet", "devrim", "diana",
-		"dilber", "dilek", "dogan", "dost", "durmus", "durriye", "ece", "eda", "edip", "ediz",
-		"efe", "efecan", "ege", "egemen", "emine", "emirhan", "emre", "emrecan", "enes", "engin",
-		"ercument", "erdem", "esen", "esin", "esra", "eylul", "fadime", "fahri", "fazilet", "feramuz",
-		"feraye", "ferhat", "ferhunde", "figen", "fikret", "fuat", "fugen", "furkan", "galip", "garo",
-		"gazi", "gizem", "gul", "gulden", "gulsah", "gulsen", "gunay", "gurbuz", "gursel", "hakan",
-		"hakki", "haldun", "halime", "haluk", "handan", "hande", "handesu", "hasan", "helin", "hikmet",
-		"hilal", "hilmi", "hulki", "hulusi", "hulya", "huseyin", "iffet", "irmak", "ismail", "izzet",
-		"jade", "julide", "kaan", "kamil", "kamile", "kasim", "kaya", "kayahan", "kayhan", "kazim",
-		"kelami", "kenan", "kerem", "kerim", "keriman", "kezban", "korhan", "kunter", "kurthan", "lale",
-		"lamia", "leyla", "mahir", "malik", "mehmet", "melek", "melih", "melike", "melisa", "menekse", "mert",
-		"metin", "mucahit", "muhsin", "mukerrem", "murat", "murathan", "muruvvet", "muslum", "mustafa", "muzaffer", "naci", "naciye",
-		"nagehan", "nahit", "nalan", "nasrullah", "naz", "nazif", "nazife", "nazli", "necmettin", "necmi",
-		"necmiye", "nedim", "nefes", "nevsin", "nihal", "nihat", "nisan", "niyazi", "nurdan", "nuri",
-		"nuriye", "nurullah", "nusret", "okan", "olcay", "onat", "orkun", "osman", "pakize", "papatya",
-		"pelin", "pelinsu", "perihan", "petek", "pinat", "polat", "polathan", "poyraz", "recep", "refik",
-		"refika", "rumeysa", "rupen", "saadet", "sabriye", "sade", "sadegul", "sadettin", "sadi", "sadiye",
-		"sadri", "sadullah", "samet", "sami", "saniye", "sarp", "sefa", "sefer", "selenay", "selin",
-		"semsit", "sevda", "sevilay", "sevim", "seyhan", "sezai", "sezen", "sezer", "sidre", "sinem",
-		"soner", "su", "suheyla", "suleyman", "sumeyye", "suphi", "taci", "taner", "tanju", "tansel",
-		"tansu", "tarcan", "tarik", "tarkan", "tayfun", "tayyar", "tayyip", "tekin", "temel", "teoman",
-		"teslime", "tevfik", "tijen", "tonguc", "tufan", "tugay", "tugra", "tunc", "tuncer", "turgut",
-		"turhan", "ufuk", "ugur", "umit", "utku", "yalcin", "yasar", "yasemin", "yasin", "emrecan",
-		"yavuz", "yelda", "yeliz", "yesim", "yilmaz", "yunus", "yurdagul", "yurdakul", "yurdanur", "yusuf",
-		"zahide", "zahit", "zarife", "zekai", "necati", "zeliha", "zerrin", "ziya", "zubeyde",
-	};
+	detail::format_append(out, val);
+}
 
-	return pnames[Irand(0, (int)(std::size(pnames)) - 1)()];
+/**
+ * @brief Returns the text `format_into` produces for a value.
+ */
+template<typename T>
+[[nodiscard]] std::string format_value(const T& val)
+{
+	std::string s;
+	detail::format_append(s, val);
+	return s;
 }
-//--------------------------------------------------
-//--------------------------------------------------
+
 /**
- * @brief Generates a random surname from a predefined list of surnames.
- *
- * This inline function returns a randomly selected surname from a predefined list of surnames.
- * The surnames are stored in a static array, and a random index is used to select one surname.
+ * @brief Prints a value of any nesting depth with one write to the stream buffer, followed by a dash line.
  *
- * @return A `std::string` containing the randomly selected surname.
+ * The whole text is built by `format_into` in a buffer reused by the calling thread, then written
+ * with a single `sputn`, so even a large structure costs one stream operation.
  *
- * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+ * @param val The value to be printed.
+ * @param os The output stream. The default is `std::cout`.
  *
  * @example
  * @code
- * std::string surname = random_surname(); // Generates a random surname from the list.
- * std::cout << "Random Surname: " << surname << std::endl;
+ * std::map<std::string, std::vector<int>> m;
+ * for (int i = 0; i < 10; ++i)
+ *     rfill(m[random_name()], 5, Irand{ 0, 100 });
+ * dump(m);
  * @endcode
  */
-inline [[nodiscard]] std::string random_surname()
+template<typename T>
+void dump(const T& val, std::ostream& os = std::cout)
 {
-	static constexpr const char* pfnames[] = {
-		"acar", "acgoze", "acuka", "ademoglu", "adiguzel", "agaoglu", "akarsu", "akcalar", "akgunes", "akkay",
-		"akkuyu", "aklikit", "aksakal", "akyildiz", "akyoldas", "alemdar", "alniacik", "altindag", "altinisik", "altinorak",
-		"arcan", "aslan", "avci", "aybeyaz", "aylak", "azmak", "bahceli", "bakirci", "baklavaci", "barutcu",
-		"baturalp", "bayraktar", "bekar", "belgeli", "beyaz", "bilgic", "bozkaya", "boztas", "canbay", "candamar",
-		"cangoz", "cankoc", "canlikaya", "cansever", "cansiz", "celik", "celiker", "cengaver", "cevikkol", "cilingir",
-		"comakci", "corbaci", "cubukay", "cuhadar", "daglarca", "damar", "degirmenci", "demirdogen", "demirel", "derin",
-		"dingin", "dokmeci", "dokuzcan", "dosteli", "dumbuk", "dunyalik", "ecevit", "edepli", "edepsiz", "efelik",
-		"elebasi", "eliagir", "elibol", "elitemiz", "elkizi", "elmali", "eloglu", "emirkulu", "engerek", "engereke",
-		"erdogan", "ergin", "erim", "ersoy", "ertakan", "esbereli", "esnedur", "esteberli", "etci", "ezergecer",
-		"fakir", "fedai", "fincan", "firatonu", "fitrat", "gamsiz", "gedik", "geldik", "gilgamis", "girik",
-		"girit", "gucsuz", "gultekin", "gumus", "gurkas", "hamsikoylu", "harmanci", "haselici", "hepguler", "hurmaci",
-		"iliksiz", "issiz", "jilet", "kabasakal", "kadersiz", "kahraman", "kalemsiz", "kalinkas", "kalpsiz", "kalpten",
-		"kapan", "kapici", "kaplan", "kara", "karabatur", "karaduman", "karaelmas", "karakis", "karakoyun", "karakuzu",
-		"karamuk", "karaorman", "karasaban", "karataban", "karayel", "kayabasi", "kazanci", "kecisakal", "kelepce", "kelleci",
-		"keskin", "kesman", "kilicdar", "kilimci", "kilinc", "kirboga", "kirci", "kocyigit", "kolcak", "komcu",
-		"komurcu", "konak", "konca", "koralp", "korukcu", "kosnuk", "kotek", "koylu", "kucukkaya", "kulaksiz",
-		"kurban", "kurtulus", "kusmen", "lalezar", "lokmaci", "lombak", "lufer", "maganda", "malazgirt", "malkaciran",
-		"mazgirt", "merdane", "mertek", "merzifon", "mirza", "miskin", "miskinoglu", "muglali", "nazik", "nurtopu",
-		"olmez", "oltu", "onaran", "ongun", "ordulu", "orhancan", "ormanci", "ortaca", "osmaneli", "otaci",
-		"ovacik", "oztoklu", "ozvezneci", "pakdamar", "pirlanta", "polatkan", "portakal", "poturgeli", "reis", "renacan",
-		"resimci", "saferikli", "safkan", "salca", "saldiray", "sallabas", "samanci", "saricakir", "sarikafa", "sarpdemir",
-		"savaskan", "sefiloglu", "selercan", "semiz", "sener", "serce", "serinsun", "sessiz", "silahdar", "silifkeli",
-		"simsek", "sivri", "sofuoglu", "sonmez", "sonuzun", "soylu", "soysalan", "soyubozuk", "sucu", "sulugoz",
-		"supuren", "takes", "tamgun", "tamirci", "tantana", "tarumar", "tekinalp", "tekkaya", "tekkilic", "telek",
-		"temiz", "temizel", "temizkalp", "tepecik", "tepsici", "tercan", "terlemez", "tertemiz", "tilki", "tokatci",
-		"tombeki", "topatan", "topkapi", "tozkoporan", "tufancan", "tunali", "tuzcu", "tuztas", "ufurukcu", "ugursuz",
-		"ulakci", "uluocak", "umutsuz", "unalan", "unalmis", "unkapani", "uraz", "uslu", "uyar", "uzay",
+	thread_local std::string buf;
+	buf.clear();
+	detail::format_append(buf, val);
+	if (std::ostream::sentry sentry{ os }; sentry) {
+		if (os.rdbuf()->sputn(buf.data(), static_cast<std::streamsize>(buf.size())) != static_cast<std::streamsize>(buf.size()))
+			os.setstate(std::ios_base::badbit);
+	}
+	os << dash_line;
+}
+
+
+//--------------------------------------------------
+//--------------------------------------------------
+
+namespace detail {
+
+	/**
+	 * @brief One step of the splitmix64 generator, used to derive well mixed seeds.
+	 */
+	constexpr std::uint64_t splitmix64_next(std::uint64_t& state) noexcept
+	{
+		std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	struct seed_registry {
+		explicit seed_registry(std::uint64_t seed) : master{ seed } {}
+
+		std::atomic<std::uint64_t> master;
+		std::atomic<std::uint64_t> epoch{ 0 };       ///< incremented whenever the master seed changes
+		std::atomic<std::uint64_t> next_stream{ 0 }; ///< stream index handed out to the next new thread
+	};
+
+	/**
+	 * @brief Returns the value of an environment variable, if it is set.
+	 */
+	[[nodiscard]] inline std::optional<std::string> get_env(const char* name)
+	{
+#if defined(_MSC_VER)
+		char* p = nullptr;
+		std::size_t len = 0;
+		if (_dupenv_s(&p, &len, name) != 0 || !p)
+			return std::nullopt;
+		std::string val{ p };
+		std::free(p);
+		return val;
+#else
+		if (const char* p = std::getenv(name))
+			return std::string{ p };
+		return std::nullopt;
+#endif
+	}
+
+	/**
+	 * @brief Parses a seed written in decimal or, with a `0x` prefix, in hexadecimal.
+	 */
+	[[nodiscard]] inline std::optional<std::uint64_t> parse_seed(std::string_view sv)
+	{
+		int base = 10;
+		if (sv.size() > 2 && sv[0] == '0' && (sv[1] == 'x' || sv[1] == 'X')) {
+			sv.remove_prefix(2);
+			base = 16;
+		}
+		std::uint64_t seed;
+		const auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), seed, base);
+		if (sv.empty() || ec != std::errc{} || ptr != sv.data() + sv.size())
+			return std::nullopt;
+		return seed;
+	}
+
+	//logging is off unless NUTILITY_SEED_LOG is set to a value other than 0, or set_seed_log is called
+	[[nodiscard]] inline std::atomic<std::ostream*>& seed_log()
+	{
+		static std::atomic<std::ostream*> os{ [] {
+			const auto env = get_env("NUTILITY_SEED_LOG");
+			return env && !env->empty() && *env != "0" ? &std::clog : nullptr;
+		}() };
+		return os;
+	}
+
+	inline void log_seed(std::uint64_t seed, const char* source)
+	{
+		if (std::ostream* os = seed_log().load(std::memory_order_acquire))
+			*os << "nutility: master seed " << seed << " (" << source << "), set NUTILITY_SEED=" << seed << " to replay\n";
+	}
+
+	/**
+	 * @brief A fresh seed mixed from the clock, an address, the thread id and a counter.
+	 *
+	 * `std::random_device` is not used: it may throw, block or be slow, and a test data seed
+	 * needs no cryptographic quality.
+	 */
+	[[nodiscard]] inline std::uint64_t entropy_seed()
+	{
+		static std::atomic<std::uint64_t> counter{ 0 };
+		std::uint64_t state = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+		state ^= reinterpret_cast<std::uintptr_t>(&counter) * 0x9E3779B97F4A7C15ull;
+		state ^= static_cast<std::uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) << 17;
+		state += counter.fetch_add(1, std::memory_order_relaxed);
+		return splitmix64_next(state);
+	}
+
+	[[nodiscard]] inline std::uint64_t initial_seed()
+	{
+		if (const auto env = get_env("NUTILITY_SEED")) {
+			if (const auto seed = parse_seed(*env)) {
+				log_seed(*seed, "NUTILITY_SEED");
+				return *seed;
+			}
+			if (std::ostream* os = seed_log().load(std::memory_order_acquire))
+				*os << "nutility: NUTILITY_SEED=" << *env << " is not a valid seed and is ignored\n";
+		}
+		const std::uint64_t seed = entropy_seed();
+		log_seed(seed, "random");
+		return seed;
+	}
+
+	[[nodiscard]] inline seed_registry& seeds()
+	{
+		static seed_registry reg{ initial_seed() };
+		return reg;
+	}
+
+	inline void publish_seed(std::uint64_t seed)
+	{
+		seeds().master.store(seed, std::memory_order_relaxed);
+		seeds().epoch.fetch_add(1, std::memory_order_release);
+	}
+
+	struct thread_seed_state {
+		static constexpr std::uint64_t unassigned = ~std::uint64_t{ 0 };
+
+		std::uint64_t stream = unassigned;
+		std::uint64_t seen_epoch = unassigned;
+		std::uint64_t generation = 0; ///< changes whenever the engines of the thread must be reseeded
+	};
+
+	[[nodiscard]] inline thread_seed_state& thread_seed_slot() noexcept
+	{
+		thread_local thread_seed_state st;
+		return st;
+	}
+
+	[[nodiscard]] inline thread_seed_state& thread_seeds()
+	{
+		auto& st = thread_seed_slot();
+		if (st.stream == thread_seed_state::unassigned)
+			st.stream = seeds().next_stream.fetch_add(1, std::memory_order_relaxed);
+		//acquire pairs with the release in publish_seed, so the new epoch is never seen with the old master seed
+		if (const auto ep = seeds().epoch.load(std::memory_order_acquire); ep != st.seen_epoch) {
+			st.seen_epoch = ep;
+			++st.generation;
+		}
+		return st;
+	}
+
+	template<typename Engine>
+	[[nodiscard]] Engine make_engine(std::uint64_t seed)
+	{
+		if constexpr (std::is_constructible_v<Engine, std::seed_seq&>) {
+			std::seed_seq sseq{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+			return Engine(sseq);
+		}
+		else {
+			return Engine(seed);
+		}
+	}
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief Returns the master seed all per-thread engines are derived from.
+ *
+ * The initial master seed is read from the environment variable `NUTILITY_SEED` (decimal or
+ * `0x` hexadecimal). If it is not set, a fresh seed is made from the clock and the process state.
+ * With `NUTILITY_SEED_LOG=1` (or after `set_seed_log`) the seed is logged when it is first needed,
+ * so any run can be replayed with the same input data by setting `NUTILITY_SEED` to the logged value.
+ */
+
+[[nodiscard]] inline std::uint64_t master_seed()
+{
+	return detail::seeds().master.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the master seed.
+ *
+ * Every thread reseeds its engines from the new master seed on its next random draw.
+ * Since each thread keeps its stream index, a program run with the same master seed
+ * (and the same stream indices, see `set_thread_stream`) reproduces the same values.
+ *
+ * @param seed The new master seed.
+ */
+
+inline void set_master_seed(std::uint64_t seed)
+{
+	detail::publish_seed(seed);
+	detail::log_seed(seed, "set_master_seed");
+}
+
+/**
+ * @brief Sets a fresh master seed made from the clock and the process state and returns it.
+ *
+ * Like `set_master_seed`, this only publishes the new seed; the engines of every thread are
+ * reseeded lazily on their next draw.
+ */
+
+inline std::uint64_t reseed()
+{
+	const std::uint64_t seed = detail::entropy_seed();
+	set_master_seed(seed);
+	return seed;
+}
+
+/**
+ * @brief Sets the stream the seeds are logged to, `nullptr` turns logging off.
+ *
+ * Logging is off by default. If the environment variable `NUTILITY_SEED_LOG` is set to a value
+ * other than `0`, the seeds are logged to `std::clog`.
+ */
+
+inline void set_seed_log(std::ostream* os)
+{
+	detail::seed_log().store(os, std::memory_order_release);
+}
+
+/**
+ * @class scoped_seed
+ * @brief Sets the master seed for its lifetime and restores the previous one when destroyed.
+ *
+ * Restoring is not logged. The engines restart from the beginning of the sequence of the
+ * restored seed, as after any change of the master seed.
+ *
+ * @example
+ * @code
+ * {
+ *     scoped_seed seed{ 42 };
+ *     rfill(ivec, 1'000'000, Irand{ 0, 1000 }); // the same data in every run
+ * }
+ * @endcode
+ */
+
+class scoped_seed {
+public:
+	explicit scoped_seed(std::uint64_t seed) : m_prev{ master_seed() }
+	{
+		set_master_seed(seed);
+	}
+
+	scoped_seed(const scoped_seed&) = delete;
+	scoped_seed& operator=(const scoped_seed&) = delete;
+
+	~scoped_seed()
+	{
+		detail::publish_seed(m_prev);
+	}
+
+private:
+	std::uint64_t m_prev;
+};
+
+/**
+ * @brief Returns the seed of a given stream under the current master seed.
+ *
+ * @param stream The stream index.
+ * @return A seed derived deterministically from the master seed and `stream`.
+ */
+
+[[nodiscard]] inline std::uint64_t stream_seed(std::uint64_t stream)
+{
+	std::uint64_t state = master_seed() ^ (stream * 0xD1B54A32D192ED03ull);
+	return detail::splitmix64_next(state);
+}
+
+/**
+ * @brief Assigns a stream index to the calling thread and reseeds its engines.
+ *
+ * Threads get stream indices in the order they first draw a random value, which depends on
+ * scheduling. Worker threads that must be reproducible should call this function with a fixed
+ * index (the main thread of a program usually gets stream 0) before generating any value.
+ *
+ * @param stream The stream index of the calling thread.
+ *
+ * @example
+ * @code
+ * std::vector<std::thread> workers;
+ * for (int i = 0; i < 8; ++i)
+ *     workers.emplace_back([i] { set_thread_stream(i + 1); Irand rand{ 0, 100 }; ... });
+ * @endcode
+ */
+
+inline void set_thread_stream(std::uint64_t stream)
+{
+	auto& st = detail::thread_seed_slot(); //does not take an index from the shared counter
+	st.stream = stream;
+	++st.generation;
+}
+
+/**
+ * @brief Returns the calling thread's instance of a random number engine.
+ *
+ * Each thread lazily creates its own engine of type `Engine`, seeded from the master seed and
+ * the thread's stream index, so threads never share an engine and need no locking.
+ *
+ * @tparam Engine A random number engine type constructible from a `std::seed_seq` or a 64-bit seed.
+ * @return A reference to the engine of the calling thread.
+ */
+
+template<typename Engine>
+[[nodiscard]] Engine& thread_engine()
+{
+	struct seeded_engine {
+		Engine eng = detail::make_engine<Engine>(0);
+		std::uint64_t generation = 0;
+	};
+
+	thread_local seeded_engine te;
+	const auto& st = detail::thread_seeds();
+	if (te.generation != st.generation) {
+		te.eng = detail::make_engine<Engine>(stream_seed(st.stream));
+		te.generation = st.generation;
+	}
+	return te.eng;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+     * @brief Provides access to the underlying random number generator.
+     *
+     * This function returns a reference to the calling thread's Mersenne Twister engine.
+     * Every thread has its own engine, seeded deterministically from the master seed
+     * (see `set_master_seed`) and the thread's stream index, so concurrent calls never race.
+     *
+     * @return A reference to a `std::mt19937` random number generator.
+     */
+
+[[nodiscard]] inline std::mt19937& urng()
+{
+    return thread_engine<std::mt19937>();
+}
+
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   fast random number engines   */
+
+namespace detail {
+
+	/**
+	 * @brief Full 64 x 64 -> 128 bit multiplication.
+	 *
+	 * @return The low 64 bits of the product, the high 64 bits are stored into `hi`.
+	 */
+	constexpr std::uint64_t mul128(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept
+	{
+#if defined(__SIZEOF_INT128__)
+		__extension__ using uint128 = unsigned __int128;
+		const uint128 p = static_cast<uint128>(a) * b;
+		hi = static_cast<std::uint64_t>(p >> 64);
+		return static_cast<std::uint64_t>(p);
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+		if (!std::is_constant_evaluated())
+			return _umul128(a, b, &hi);
+#endif
+		const std::uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+		const std::uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+		const std::uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+		const std::uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFF) + (p2 & 0xFFFFFFFF);
+		hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+		return (mid << 32) | (p0 & 0xFFFFFFFF);
+#endif
+	}
+}
+
+/**
+ * @brief The splitmix64 engine (Steele, Lea, Flood).
+ *
+ * 64 bits of state, one addition and two multiplications per value. Mostly useful for seeding
+ * other engines; it satisfies the UniformRandomBitGenerator requirements and can be used with
+ * the standard distributions, `Irand` and `Drand`.
+ */
+
+class splitmix64 {
+public:
+	using result_type = std::uint64_t;
+
+	constexpr explicit splitmix64(std::uint64_t seed = 0) noexcept : m_state{ seed } {}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~result_type{ 0 }; }
+
+	constexpr result_type operator()() noexcept
+	{
+		return detail::splitmix64_next(m_state);
+	}
+
+	constexpr void discard(unsigned long long n) noexcept
+	{
+		m_state += n * 0x9E3779B97F4A7C15ull;
+	}
+
+	friend constexpr bool operator==(const splitmix64&, const splitmix64&) = default;
+
+private:
+	std::uint64_t m_state;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief The xoshiro256** engine (Blackman, Vigna).
+ *
+ * 256 bits of state and a period of 2^256 - 1. `jump()` advances the engine by 2^128 steps
+ * and `long_jump()` by 2^192 steps, which provides non-overlapping subsequences for parallel
+ * generation.
+ */
+
+class xoshiro256ss {
+public:
+	using result_type = std::uint64_t;
+
+	/**
+	 * @brief Constructs the engine, expanding `seed` into the state with splitmix64.
+	 */
+	constexpr explicit xoshiro256ss(std::uint64_t seed = 0) noexcept
+	{
+		this->seed(seed);
+	}
+
+	constexpr void seed(std::uint64_t seed) noexcept
+	{
+		for (auto& x : m_s)
+			x = detail::splitmix64_next(seed);
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~result_type{ 0 }; }
+
+	constexpr result_type operator()() noexcept
+	{
+		const std::uint64_t result = std::rotl(m_s[1] * 5, 7) * 9;
+		const std::uint64_t t = m_s[1] << 17;
+		m_s[2] ^= m_s[0];
+		m_s[3] ^= m_s[1];
+		m_s[1] ^= m_s[2];
+		m_s[0] ^= m_s[3];
+		m_s[2] ^= t;
+		m_s[3] = std::rotl(m_s[3], 45);
+		return result;
+	}
+
+	constexpr void discard(unsigned long long n) noexcept
+	{
+		while (n--)
+			(*this)();
+	}
+
+	/**
+	 * @brief Advances the engine by 2^128 steps.
+	 */
+	constexpr void jump() noexcept
+	{
+		constexpr std::uint64_t poly[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+		apply(poly);
+	}
+
+	/**
+	 * @brief Advances the engine by 2^192 steps.
+	 */
+	constexpr void long_jump() noexcept
+	{
+		constexpr std::uint64_t poly[] = { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull };
+		apply(poly);
+	}
+
+	friend constexpr bool operator==(const xoshiro256ss&, const xoshiro256ss&) = default;
+
+private:
+	friend class xoshiro256x4;
+
+	constexpr void apply(const std::uint64_t(&poly)[4]) noexcept
+	{
+		std::uint64_t s[4]{};
+		for (const auto word : poly) {
+			for (int b = 0; b < 64; ++b) {
+				if (word & (std::uint64_t{ 1 } << b))
+					for (int i = 0; i < 4; ++i)
+						s[i] ^= m_s[i];
+				(*this)();
+			}
+		}
+		for (int i = 0; i < 4; ++i)
+			m_s[i] = s[i];
+	}
+
+	std::uint64_t m_s[4]{};
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief The PCG64 engine (O'Neill), 128-bit LCG state with the XSL-RR output function.
+ *
+ * Besides the seed, a stream number selects one of 2^63 independent sequences, which makes
+ * it easy to give every worker of a parallel job its own engine.
+ */
+
+class pcg64 {
+public:
+	using result_type = std::uint64_t;
+
+	constexpr explicit pcg64(std::uint64_t seed = 0, std::uint64_t stream = 0) noexcept
+	{
+		this->seed(seed, stream);
+	}
+
+	constexpr void seed(std::uint64_t seed, std::uint64_t stream = 0) noexcept
+	{
+		m_inc_hi = stream >> 63;
+		m_inc_lo = (stream << 1) | 1;
+		m_hi = m_lo = 0;
+		step();
+		std::uint64_t sm = seed;
+		add(detail::splitmix64_next(sm), detail::splitmix64_next(sm));
+		step();
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~result_type{ 0 }; }
+
+	constexpr result_type operator()() noexcept
+	{
+		step();
+		return std::rotr(m_hi ^ m_lo, static_cast<int>(m_hi >> 58));
+	}
+
+	constexpr void discard(unsigned long long n) noexcept
+	{
+		while (n--)
+			step();
+	}
+
+	friend constexpr bool operator==(const pcg64&, const pcg64&) = default;
+
+private:
+	constexpr void add(std::uint64_t hi, std::uint64_t lo) noexcept
+	{
+		m_lo += lo;
+		m_hi += hi + (m_lo < lo);
+	}
+
+	constexpr void step() noexcept
+	{
+		constexpr std::uint64_t mult_hi = 0x2360ED051FC65DA4ull;
+		constexpr std::uint64_t mult_lo = 0x4385DF649FCCF645ull;
+
+		std::uint64_t carry{};
+		const std::uint64_t lo = detail::mul128(m_lo, mult_lo, carry);
+		m_hi = carry + m_lo * mult_hi + m_hi * mult_lo;
+		m_lo = lo;
+		add(m_inc_hi, m_inc_lo);
+	}
+
+	std::uint64_t m_hi{}, m_lo{};
+	std::uint64_t m_inc_hi{}, m_inc_lo{};
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief The wyrand engine (Wang Yi).
+ *
+ * 64 bits of state and a single 64 x 64 -> 128 bit multiplication per value. This is usually
+ * the fastest of the engines provided here.
+ */
+
+class wyrand {
+public:
+	using result_type = std::uint64_t;
+
+	constexpr explicit wyrand(std::uint64_t seed = 0) noexcept : m_state{ seed } {}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~result_type{ 0 }; }
+
+	constexpr result_type operator()() noexcept
+	{
+		m_state += 0xA0761D6478BD642Full;
+		std::uint64_t hi{};
+		const std::uint64_t lo = detail::mul128(m_state, m_state ^ 0xE7037ED1A0B428DBull, hi);
+		return hi ^ lo;
+	}
+
+	constexpr void discard(unsigned long long n) noexcept
+	{
+		m_state += n * 0xA0761D6478BD642Full;
+	}
+
+	friend constexpr bool operator==(const wyrand&, const wyrand&) = default;
+
+private:
+	std::uint64_t m_state;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief Four interleaved xoshiro256** engines for bulk generation.
+ *
+ * The state of the four lanes is stored word by word, so one step of all lanes is a handful of
+ * 256-bit vector instructions. An explicit AVX2 implementation is used when the translation unit
+ * is compiled with AVX2 enabled; otherwise the lane loops are plain scalar code that compilers
+ * vectorize for SSE2, AVX-512 or NEON targets. Lane `k` is the engine seeded with `seed` and
+ * advanced by `k` calls of `xoshiro256ss::jump()`, so the lanes never overlap.
+ */
+
+class xoshiro256x4 {
+public:
+	static constexpr std::size_t lanes = 4;
+
+	explicit xoshiro256x4(std::uint64_t seed = 0) noexcept
+	{
+		this->seed(seed);
+	}
+
+	void seed(std::uint64_t seed) noexcept
+	{
+		xoshiro256ss eng{ seed };
+		for (std::size_t lane = 0; lane < lanes; ++lane) {
+			for (std::size_t w = 0; w < 4; ++w)
+				m_s[w][lane] = eng.m_s[w];
+			eng.jump();
+		}
+	}
+
+	/**
+	 * @brief Writes `n` random 64-bit values into `out`.
+	 */
+	void fill(std::uint64_t* out, std::size_t n) noexcept
+	{
+		while (n >= lanes) {
+			next(out);
+			out += lanes;
+			n -= lanes;
+		}
+		if (n) {
+			std::uint64_t tail[lanes];
+			next(tail);
+			std::copy_n(tail, n, out);
+		}
+	}
+
+private:
+	void next(std::uint64_t* out) noexcept
+	{
+#if defined(__AVX2__)
+		const auto rotl = [](__m256i x, int k) {
+			return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+		};
+		__m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_s[0]));
+		__m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_s[1]));
+		__m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_s[2]));
+		__m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_s[3]));
+
+		const __m256i x5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+		const __m256i r = rotl(x5, 7);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi64(_mm256_slli_epi64(r, 3), r));
+
+		const __m256i t = _mm256_slli_epi64(s1, 17);
+		s2 = _mm256_xor_si256(s2, s0);
+		s3 = _mm256_xor_si256(s3, s1);
+		s1 = _mm256_xor_si256(s1, s2);
+		s0 = _mm256_xor_si256(s0, s3);
+		s2 = _mm256_xor_si256(s2, t);
+		s3 = rotl(s3, 45);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[0]), s0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[1]), s1);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[2]), s2);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(m_s[3]), s3);
+#else
+		for (std::size_t i = 0; i < lanes; ++i)
+			out[i] = std::rotl(m_s[1][i] * 5, 7) * 9;
+
+		for (std::size_t i = 0; i < lanes; ++i) {
+			const std::uint64_t t = m_s[1][i] << 17;
+			m_s[2][i] ^= m_s[0][i];
+			m_s[3][i] ^= m_s[1][i];
+			m_s[1][i] ^= m_s[2][i];
+			m_s[0][i] ^= m_s[3][i];
+			m_s[2][i] ^= t;
+			m_s[3][i] = std::rotl(m_s[3][i], 45);
+		}
+#endif
+	}
+
+	alignas(32) std::uint64_t m_s[4][lanes]{};
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief Provides access to the calling thread's fast 64-bit engine.
+ *
+ * Like `urng()`, but returns a per-thread `xoshiro256ss`. It is seeded from the same master
+ * seed, so it is reproducible in the same way. `urng()` stays the default engine of the library.
+ *
+ * @example
+ * @code
+ * Irand rand{ 0, 100 };
+ * int val = rand(fast_urng());
+ * @endcode
+ */
+
+[[nodiscard]] inline xoshiro256ss& fast_urng()
+{
+	return thread_engine<xoshiro256ss>();
+}
+
+/**
+ * @brief Provides access to the calling thread's multi-lane engine used by the bulk generators.
+ *
+ * Seeded from the master seed like `urng()`. `Irand::generate` and `Drand::generate` draw
+ * from this engine unless an engine is given explicitly.
+ */
+
+[[nodiscard]] inline xoshiro256x4& batch_urng()
+{
+	return thread_engine<xoshiro256x4>();
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+namespace detail {
+
+	inline constexpr std::size_t batch_size = 512;
+
+	/**
+	 * @brief Writes `n` random 64-bit values produced by `eng` into `out`.
+	 *
+	 * Multi-lane engines are asked for the whole block at once, 32-bit engines
+	 * (e.g. `std::mt19937`) contribute two calls per value.
+	 */
+	template<typename Engine>
+	void fill_bits(Engine& eng, std::uint64_t* out, std::size_t n)
+	{
+		if constexpr (requires { eng.fill(out, n); }) {
+			eng.fill(out, n);
+		}
+		else {
+			static_assert(Engine::min() == 0 && (Engine::max() == 0xFFFFFFFFull || Engine::max() == ~std::uint64_t{ 0 }),
+				"the engine must produce 32 or 64 uniformly distributed bits");
+			for (std::size_t i = 0; i < n; ++i) {
+				if constexpr (Engine::max() == 0xFFFFFFFFull) {
+					//the evaluation order of the operands of | is unspecified, keep the draws in sequence
+					const std::uint64_t hi = eng();
+					const std::uint64_t lo = eng();
+					out[i] = (hi << 32) | lo;
+				}
+				else
+					out[i] = eng();
+			}
+		}
+	}
+
+	template<typename Engine>
+	[[nodiscard]] std::uint32_t random_u32(Engine& eng)
+	{
+		std::uint64_t x;
+		fill_bits(eng, &x, 1);
+		return static_cast<std::uint32_t>(x >> 32);
+	}
+
+	/**
+	 * @brief Bulk uniform integers in [min, max] with Lemire's multiply-shift range reduction.
+	 *
+	 * Two 32-bit draws are taken from every 64-bit value. The rejection step keeps the result
+	 * exactly uniform and is taken with probability below `range / 2^32`.
+	 */
+	template<typename Engine>
+	void generate_int(int min, int max, int* out, std::size_t n, Engine& eng)
+	{
+		const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+		const auto lo = static_cast<std::uint32_t>(min);
+		const auto bound = static_cast<std::uint32_t>(range); //0 if the range is the full 32-bit range
+		const std::uint32_t threshold = bound ? static_cast<std::uint32_t>(-bound) % bound : 0;
+
+		std::uint64_t buf[batch_size];
+		while (n) {
+			const std::size_t cnt = std::min(n, 2 * batch_size);
+			fill_bits(eng, buf, (cnt + 1) / 2);
+			for (std::size_t i = 0; i < cnt; ++i) {
+				const auto x = static_cast<std::uint32_t>(buf[i / 2] >> (i % 2 * 32));
+				if (!bound) {
+					out[i] = static_cast<int>(lo + x);
+					continue;
+				}
+				std::uint64_t m = static_cast<std::uint64_t>(x) * bound;
+				while (static_cast<std::uint32_t>(m) < threshold)
+					m = static_cast<std::uint64_t>(random_u32(eng)) * bound;
+				out[i] = static_cast<int>(lo + static_cast<std::uint32_t>(m >> 32));
+			}
+			out += cnt;
+			n -= cnt;
+		}
+	}
+
+	/**
+	 * @brief Bulk uniform doubles in [min, max).
+	 *
+	 * The top 52 random bits are put into the mantissa of a double in [1, 2), so the conversion
+	 * to [0, 1) is a bit operation and one subtraction.
+	 */
+	template<typename Engine>
+	void generate_real(double min, double max, double* out, std::size_t n, Engine& eng)
+	{
+		const double width = max - min;
+		std::uint64_t buf[batch_size];
+		while (n) {
+			const std::size_t cnt = std::min(n, batch_size);
+			fill_bits(eng, buf, cnt);
+			for (std::size_t i = 0; i < cnt; ++i) {
+				const double u = std::bit_cast<double>((buf[i] >> 12) | 0x3FF0000000000000ull) - 1.0;
+				out[i] = min + u * width;
+			}
+			out += cnt;
+			n -= cnt;
+		}
+	}
+}
+
+
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+
+/**
+ * @class Irand
+ * @brief A class for generating random integers within a specified range.
+ *
+ * The `Irand` class encapsulates a random number generator that produces
+ * integers within a specified range using the Mersenne Twister engine.
+ */
+
+class Irand {
+public:
+    /**
+     * @brief Default constructor for the `Irand` class.
+     *
+     * Constructs an `Irand` object without initializing the distribution range.
+     */
+    Irand() = default;
+
+    /**
+     * @brief Constructs an `Irand` object with a specified range.
+     *
+     * @param min The lower bound (inclusive) of the range.
+     * @param max The upper bound (inclusive) of the range.
+     *
+     * Initializes the random number generator to produce values in the range [min, max].
+     */
+    Irand(int min, int max) : m_dist{ min, max } {}
+
+    /**
+     * @brief Returns the lower bound (inclusive) of the range.
+     */
+    [[nodiscard]] int min() const
+    {
+        return m_dist.a();
+    }
+
+    /**
+     * @brief Returns the upper bound (inclusive) of the range.
+     */
+    [[nodiscard]] int max() const
+    {
+        return m_dist.b();
+    }
+
+
+    /**
+     * @brief Generates a random integer within the specified range.
+     *
+     * This function overloads the function call operator to produce a random integer
+     * within the range [min, max] specified during the construction of the `Irand` object.
+     *
+     * @return A random integer within the range [min, max].
+     */
+    [[nodiscard]] int operator()()
+    {
+        return m_dist(urng());
+    }
+
+    /**
+     * @brief Generates a random integer within the specified range using the given engine.
+     *
+     * @tparam URBG A type satisfying the UniformRandomBitGenerator requirements.
+     * @param eng The engine used instead of `urng()`.
+     * @return A random integer within the range [min, max].
+     */
+    template<typename URBG>
+    [[nodiscard]] int operator()(URBG& eng)
+    {
+        return m_dist(eng);
+    }
+
+    /**
+     * @brief Writes `n` random integers within the range [min, max] into `out`.
+     *
+     * The values are produced in blocks from the calling thread's multi-lane engine
+     * (`batch_urng()`) with Lemire's range reduction, which is much faster than calling
+     * `operator()` `n` times. The values are uniformly distributed, but the sequence differs
+     * from the one `operator()` would produce.
+     *
+     * @param out Pointer to the first of `n` elements to be written.
+     * @param n The number of values to be generated.
+     *
+     * @example
+     * @code
+     * std::vector<int> ivec(100'000'000);
+     * Irand{ 0, 1000 }.generate(ivec.data(), ivec.size());
+     * @endcode
+     */
+    void generate(int* out, std::size_t n)
+    {
+        generate(out, n, batch_urng());
+    }
+
+    /**
+     * @brief Writes `n` random integers within the range [min, max] into `out`, using the given engine.
+     *
+     * @tparam Engine `xoshiro256x4` or an engine producing 32 or 64 random bits per call.
+     */
+    template<typename Engine>
+    void generate(int* out, std::size_t n, Engine& eng)
+    {
+        detail::generate_int(min(), max(), out, n, eng);
+    }
+
+private:
+    std::uniform_int_distribution<int> m_dist;  /**< The distribution used to generate random integers within a specified range. */
+};
+
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief A class for generating random double-precision floating-point numbers within a specified range.
+ *
+ * The `Drand` class provides functionality to generate random `double` values uniformly distributed
+ * within a given range [dmin, dmax]. The range is specified during object construction.
+ */
+class Drand {
+public:
+	/**
+	 * @brief Default constructor.
+	 *
+	 * Constructs a `Drand` object without initializing the distribution range.
+	 * The range must be specified before using the object to generate random numbers.
+	 */
+	Drand() = default;
+
+	/**
+	 * @brief Constructs a `Drand` object with a specified range.
+	 *
+	 * Initializes the random number generator to produce double-precision floating-point numbers
+	 * within the range [dmin, dmax].
+	 *
+	 * @param dmin The minimum value of the range.
+	 * @param dmax The maximum value of the range.
+	 */
+	Drand(double dmin, double dmax) : m_dist{ dmin, dmax } {}
+
+	/**
+	 * @brief Generates a random double within the specified range.
+	 *
+	 * Returns a random double value uniformly distributed within the range [dmin, dmax]
+	 * specified during the construction of the `Drand` object.
+	 *
+	 * @return A random double value within the range [dmin, dmax].
+	 *
+	 * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+	 */
+	[[nodiscard]] double operator()()
+	{
+		return m_dist(urng());
+	}
+
+	/**
+	 * @brief Generates a random double within the specified range using the given engine.
+	 *
+	 * @tparam URBG A type satisfying the UniformRandomBitGenerator requirements.
+	 * @param eng The engine used instead of `urng()`.
+	 * @return A random double value within the range [dmin, dmax].
+	 */
+	template<typename URBG>
+	[[nodiscard]] double operator()(URBG& eng)
+	{
+		return m_dist(eng);
+	}
+
+	/**
+	 * @brief Writes `n` random doubles within the range [dmin, dmax) into `out`.
+	 *
+	 * The values are produced in blocks from the calling thread's multi-lane engine
+	 * (`batch_urng()`); each one carries 52 random mantissa bits.
+	 *
+	 * @param out Pointer to the first of `n` elements to be written.
+	 * @param n The number of values to be generated.
+	 */
+	void generate(double* out, std::size_t n)
+	{
+		generate(out, n, batch_urng());
+	}
+
+	/**
+	 * @brief Writes `n` random doubles within the range [dmin, dmax) into `out`, using the given engine.
+	 *
+	 * @tparam Engine `xoshiro256x4` or an engine producing 32 or 64 random bits per call.
+	 */
+	template<typename Engine>
+	void generate(double* out, std::size_t n, Engine& eng)
+	{
+		detail::generate_real(m_dist.a(), m_dist.b(), out, n, eng);
+	}
+
+private:
+	std::uniform_real_distribution<double> m_dist;  ///< Distribution for generating random doubles in the specified range.
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   skewed distributions   */
+
+namespace detail {
+
+	template<typename Engine>
+	[[nodiscard]] std::uint64_t random_u64(Engine& eng)
+	{
+		std::uint64_t x;
+		fill_bits(eng, &x, 1);
+		return x;
+	}
+
+	/**
+	 * @brief Converts 64 random bits to a double in [0, 1).
+	 */
+	[[nodiscard]] constexpr double unit_real(std::uint64_t x) noexcept
+	{
+		return static_cast<double>(x >> 11) * 0x1p-53;
+	}
+
+	/**
+	 * @brief Converts 64 random bits to a double in (0, 1], safe as an argument of `log`.
+	 */
+	[[nodiscard]] constexpr double unit_real_open(std::uint64_t x) noexcept
+	{
+		return static_cast<double>((x >> 11) + 1) * 0x1p-53;
+	}
+
+	/**
+	 * @brief The shared batch path of the skewed distributions.
+	 *
+	 * Every value is made from one 64-bit draw taken from a block; the rare rejection steps
+	 * draw additional values from the engine directly.
+	 */
+	template<typename Dist, typename T, typename Engine>
+	void generate_sampled(const Dist& dist, T* out, std::size_t n, Engine& eng)
+	{
+		std::uint64_t buf[batch_size];
+		while (n) {
+			const std::size_t cnt = std::min(n, batch_size);
+			fill_bits(eng, buf, cnt);
+			for (std::size_t i = 0; i < cnt; ++i)
+				out[i] = dist.sample(buf[i], eng);
+			out += cnt;
+			n -= cnt;
+		}
+	}
+
+	/**
+	 * @brief The layers of the 128 block ziggurat for the standard normal distribution (Marsaglia & Tsang, Doornik's ZIGNOR).
+	 */
+	struct ziggurat_table {
+		static constexpr int blocks = 128;
+		static constexpr double r = 3.442619855899;
+		static constexpr double v = 9.91256303526217e-3;
+
+		double x[blocks + 1];
+		double ratio[blocks];
+
+		ziggurat_table() noexcept
+		{
+			double f = std::exp(-0.5 * r * r);
+			x[0] = v / f;
+			x[1] = r;
+			x[blocks] = 0;
+			for (int i = 2; i < blocks; ++i) {
+				x[i] = std::sqrt(-2 * std::log(v / x[i - 1] + f));
+				f = std::exp(-0.5 * x[i] * x[i]);
+			}
+			for (int i = 0; i < blocks; ++i)
+				ratio[i] = x[i + 1] / x[i];
+		}
+	};
+
+	[[nodiscard]] inline const ziggurat_table& ziggurat() noexcept
+	{
+		static const ziggurat_table table;
+		return table;
+	}
+
+	/**
+	 * @brief A standard normal value; the sign and the position come from the top 53 bits, the block from the lowest 7.
+	 */
+	template<typename Engine>
+	[[nodiscard]] double standard_normal(std::uint64_t bits, Engine& eng)
+	{
+		const ziggurat_table& zt = ziggurat();
+		for (;;) {
+			const double u = 2 * unit_real(bits) - 1;
+			const auto i = static_cast<int>(bits & (ziggurat_table::blocks - 1));
+			if (std::abs(u) < zt.ratio[i])
+				return u * zt.x[i];
+			if (i == 0) {
+				double x, y;
+				do {
+					x = std::log(unit_real_open(random_u64(eng))) / ziggurat_table::r;
+					y = std::log(unit_real_open(random_u64(eng)));
+				} while (-2 * y < x * x);
+				return u < 0 ? x - ziggurat_table::r : ziggurat_table::r - x;
+			}
+			const double x = u * zt.x[i];
+			const double f0 = std::exp(-0.5 * (zt.x[i] * zt.x[i] - x * x));
+			const double f1 = std::exp(-0.5 * (zt.x[i + 1] * zt.x[i + 1] - x * x));
+			if (f1 + unit_real(random_u64(eng)) * (f0 - f1) < 1.)
+				return x;
+			bits = random_u64(eng);
+		}
+	}
+}
+
+/**
+ * @class Zipfrand
+ * @brief Generates integers in [1, n] following Zipf's law: the probability of `k` is proportional to `1 / k^s`.
+ *
+ * Sampling uses Hörmann and Derflinger's rejection-inversion method, so it takes constant time
+ * for every `n` and no table is built. Rank 1 is the most frequent value.
+ *
+ * @example
+ * @code
+ * std::vector<int> keys;
+ * rfill(keys, 1'000'000, Zipfrand{ 100'000, 0.99 });
+ * @endcode
+ */
+
+class Zipfrand {
+public:
+	/**
+	 * @param n The number of elements (the largest value generated), at least 1.
+	 * @param s The exponent, greater than 0. The default 1 is the classic Zipf distribution.
+	 */
+	explicit Zipfrand(int n, double s = 1.) : m_n{ n < 1 ? 1 : n }, m_s{ s }
+	{
+		if (!(s > 0))
+			throw std::invalid_argument{ "Zipfrand : the exponent must be positive!\n" };
+		m_h_integral_x1 = h_integral(1.5) - 1.;
+		m_h_integral_n = h_integral(m_n + 0.5);
+		m_threshold = 2. - h_integral_inverse(h_integral(2.5) - h(2.));
+	}
+
+	[[nodiscard]] int n() const noexcept
+	{
+		return m_n;
+	}
+
+	[[nodiscard]] double exponent() const noexcept
+	{
+		return m_s;
+	}
+
+	[[nodiscard]] int operator()()
+	{
+		return (*this)(fast_urng());
+	}
+
+	/**
+	 * @tparam URBG An engine producing 32 or 64 uniformly distributed bits per call.
+	 */
+	template<typename URBG>
+	[[nodiscard]] int operator()(URBG& eng)
+	{
+		return sample(detail::random_u64(eng), eng);
+	}
+
+	/**
+	 * @brief Writes `n` values into `out`, drawing the random bits in blocks from `batch_urng()`.
+	 */
+	void generate(int* out, std::size_t n)
+	{
+		generate(out, n, batch_urng());
+	}
+
+	template<typename Engine>
+	void generate(int* out, std::size_t n, Engine& eng)
+	{
+		detail::generate_sampled(*this, out, n, eng);
+	}
+
+	template<typename Engine>
+	[[nodiscard]] int sample(std::uint64_t bits, Engine& eng) const
+	{
+		for (;;) {
+			const double u = m_h_integral_n + detail::unit_real(bits) * (m_h_integral_x1 - m_h_integral_n);
+			const double x = h_integral_inverse(u);
+			double k = std::floor(x + 0.5);
+			if (k < 1.)
+				k = 1.;
+			else if (k > m_n)
+				k = m_n;
+			if (k - x <= m_threshold || u >= h_integral(k + 0.5) - h(k))
+				return static_cast<int>(k);
+			bits = detail::random_u64(eng);
+		}
+	}
+
+private:
+	//log1p(x) / x and expm1(x) / x, continued by their series around 0
+	[[nodiscard]] static double helper1(double x) noexcept
+	{
+		return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1. - x * (0.5 - x * (1. / 3 - 0.25 * x));
+	}
+
+	[[nodiscard]] static double helper2(double x) noexcept
+	{
+		return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1. + x * 0.5 * (1. + x / 3 * (1. + 0.25 * x));
+	}
+
+	[[nodiscard]] double h(double x) const noexcept
+	{
+		return std::exp(-m_s * std::log(x));
+	}
+
+	[[nodiscard]] double h_integral(double x) const noexcept
+	{
+		const double log_x = std::log(x);
+		return helper2((1. - m_s) * log_x) * log_x;
+	}
+
+	[[nodiscard]] double h_integral_inverse(double x) const noexcept
+	{
+		double t = x * (1. - m_s);
+		if (t < -1.)
+			t = -1.;
+		return std::exp(helper1(t) * x);
+	}
+
+	int m_n;
+	double m_s;
+	double m_h_integral_x1;
+	double m_h_integral_n;
+	double m_threshold;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class Paretorand
+ * @brief Generates Pareto (power-law) distributed doubles: `P(X > x) = (xm / x)^alpha` for `x >= xm`.
+ *
+ * @example
+ * @code
+ * std::vector<double> sizes;
+ * rfill(sizes, 100'000, Paretorand{ 1., 1.16 }); // the 80-20 rule
+ * @endcode
+ */
+
+class Paretorand {
+public:
+	/**
+	 * @param xm The scale, the smallest value generated, greater than 0.
+	 * @param alpha The shape, greater than 0. Smaller values give heavier tails.
+	 */
+	Paretorand(double xm, double alpha) : m_xm{ xm }, m_inv_alpha{ 1. / alpha }
+	{
+		if (!(xm > 0) || !(alpha > 0))
+			throw std::invalid_argument{ "Paretorand : the scale and the shape must be positive!\n" };
+	}
+
+	[[nodiscard]] double operator()()
+	{
+		return (*this)(fast_urng());
+	}
+
+	template<typename URBG>
+	[[nodiscard]] double operator()(URBG& eng)
+	{
+		return sample(detail::random_u64(eng), eng);
+	}
+
+	void generate(double* out, std::size_t n)
+	{
+		generate(out, n, batch_urng());
+	}
+
+	template<typename Engine>
+	void generate(double* out, std::size_t n, Engine& eng)
+	{
+		detail::generate_sampled(*this, out, n, eng);
+	}
+
+	template<typename Engine>
+	[[nodiscard]] double sample(std::uint64_t bits, Engine&) const noexcept
+	{
+		return m_xm * std::exp(-std::log(detail::unit_real_open(bits)) * m_inv_alpha);
+	}
+
+private:
+	double m_xm;
+	double m_inv_alpha;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class Gaussrand
+ * @brief Generates normally distributed doubles with the ziggurat method.
+ *
+ * About 98% of the values cost one 64-bit draw, a multiplication and a comparison.
+ *
+ * @example
+ * @code
+ * std::vector<double> dvec;
+ * rfill(dvec, 100'000, Gaussrand{ 100., 15. });
+ * @endcode
+ */
+
+class Gaussrand {
+public:
+	/**
+	 * @param mean The mean of the distribution.
+	 * @param stddev The standard deviation of the distribution.
+	 */
+	explicit Gaussrand(double mean = 0., double stddev = 1.) : m_mean{ mean }, m_stddev{ stddev } {}
+
+	[[nodiscard]] double operator()()
+	{
+		return (*this)(fast_urng());
+	}
+
+	template<typename URBG>
+	[[nodiscard]] double operator()(URBG& eng)
+	{
+		return sample(detail::random_u64(eng), eng);
+	}
+
+	void generate(double* out, std::size_t n)
+	{
+		generate(out, n, batch_urng());
+	}
+
+	template<typename Engine>
+	void generate(double* out, std::size_t n, Engine& eng)
+	{
+		detail::generate_sampled(*this, out, n, eng);
+	}
+
+	template<typename Engine>
+	[[nodiscard]] double sample(std::uint64_t bits, Engine& eng) const
+	{
+		return m_mean + m_stddev * detail::standard_normal(bits, eng);
+	}
+
+private:
+	double m_mean;
+	double m_stddev;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class Lognormrand
+ * @brief Generates lognormally distributed doubles: `exp(m + s * Z)` with a standard normal `Z`.
+ *
+ * @example
+ * @code
+ * std::vector<double> latencies;
+ * rfill(latencies, 100'000, Lognormrand{ 0., 0.5 });
+ * @endcode
+ */
+
+class Lognormrand {
+public:
+	/**
+	 * @param m The mean of the underlying normal distribution.
+	 * @param s The standard deviation of the underlying normal distribution.
+	 */
+	explicit Lognormrand(double m = 0., double s = 1.) : m_m{ m }, m_s{ s } {}
+
+	[[nodiscard]] double operator()()
+	{
+		return (*this)(fast_urng());
+	}
+
+	template<typename URBG>
+	[[nodiscard]] double operator()(URBG& eng)
+	{
+		return sample(detail::random_u64(eng), eng);
+	}
+
+	void generate(double* out, std::size_t n)
+	{
+		generate(out, n, batch_urng());
+	}
+
+	template<typename Engine>
+	void generate(double* out, std::size_t n, Engine& eng)
+	{
+		detail::generate_sampled(*this, out, n, eng);
+	}
+
+	template<typename Engine>
+	[[nodiscard]] double sample(std::uint64_t bits, Engine& eng) const
+	{
+		return std::exp(m_m + m_s * detail::standard_normal(bits, eng));
+	}
+
+private:
+	double m_m;
+	double m_s;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class Hotcoldrand
+ * @brief Generates integers in [min, max] where a small hot set receives most of the draws.
+ *
+ * The hot set is the lowest `hot_fraction` part of the range; a value is drawn uniformly from
+ * it with probability `hot_probability`, otherwise uniformly from the remaining cold part.
+ *
+ * @example
+ * @code
+ * std::vector<int> keys;
+ * rfill(keys, 1'000'000, Hotcoldrand{ 0, 999'999, 0.2, 0.8 }); // 80% of the accesses go to 20% of the keys
+ * @endcode
+ */
+
+class Hotcoldrand {
+public:
+	/**
+	 * @param min The lower bound (inclusive) of the range.
+	 * @param max The upper bound (inclusive) of the range.
+	 * @param hot_fraction The part of the range forming the hot set, in (0, 1).
+	 * @param hot_probability The probability of drawing from the hot set, in [0, 1].
+	 */
+	Hotcoldrand(int min, int max, double hot_fraction, double hot_probability) : m_min{ min }
+	{
+		if (max < min || !(hot_fraction > 0 && hot_fraction < 1) || !(hot_probability >= 0 && hot_probability <= 1))
+			throw std::invalid_argument{ "Hotcoldrand : invalid arguments!\n" };
+		const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+		if (range < 2)
+			throw std::invalid_argument{ "Hotcoldrand : the range must contain at least two values!\n" };
+		m_hot = static_cast<std::uint64_t>(static_cast<double>(range) * hot_fraction);
+		m_hot = std::clamp<std::uint64_t>(m_hot, 1, range - 1);
+		m_cold = range - m_hot;
+		m_threshold = static_cast<std::uint64_t>(hot_probability * 0x1p32);
+	}
+
+	[[nodiscard]] int operator()()
+	{
+		return (*this)(fast_urng());
+	}
+
+	template<typename URBG>
+	[[nodiscard]] int operator()(URBG& eng)
+	{
+		return sample(detail::random_u64(eng), eng);
+	}
+
+	void generate(int* out, std::size_t n)
+	{
+		generate(out, n, batch_urng());
+	}
+
+	template<typename Engine>
+	void generate(int* out, std::size_t n, Engine& eng)
+	{
+		detail::generate_sampled(*this, out, n, eng);
+	}
+
+	//the upper 32 bits choose the set, the lower 32 bits the value within it
+	template<typename Engine>
+	[[nodiscard]] int sample(std::uint64_t bits, Engine& eng) const
+	{
+		const bool hot = (bits >> 32) < m_threshold;
+		const std::uint64_t bound = hot ? m_hot : m_cold;
+		const std::uint64_t t = (std::uint64_t{ 1 } << 32) % bound;
+		std::uint64_t m = (bits & 0xFFFFFFFFu) * bound;
+		while ((m & 0xFFFFFFFFu) < t)
+			m = detail::random_u32(eng) * bound;
+		const std::uint64_t offset = (m >> 32) + (hot ? 0 : m_hot);
+		return static_cast<int>(static_cast<std::int64_t>(m_min) + static_cast<std::int64_t>(offset));
+	}
+
+private:
+	int m_min;
+	std::uint64_t m_hot;
+	std::uint64_t m_cold;
+	std::uint64_t m_threshold;
+};
+//------------------------------------------------------
+//------------------------------------------------------
+
+namespace detail {
+
+	/**
+	 * @brief Open-addressing (linear probing) hash set used to collect distinct values.
+	 *
+	 * The values are kept contiguously in insertion order, the probe table only stores
+	 * 32-bit indices into that storage. The table is never more than half full.
+	 */
+	template<typename T, typename Hash = std::hash<T>>
+	class distinct_collector {
+	public:
+		explicit distinct_collector(std::size_t n)
+		{
+			if (n >= std::numeric_limits<std::uint32_t>::max() / 2)
+				throw std::length_error{ "distinct_collector: too many values\n" };
+
+			std::size_t table_size = 16;
+			m_shift = 60;
+			while (table_size < 2 * n) {
+				table_size <<= 1;
+				--m_shift;
+			}
+			m_table.assign(table_size, 0);
+			m_values.reserve(n);
+		}
+
+		bool insert(const T& val)
+		{
+			const std::size_t mask = m_table.size() - 1;
+			for (std::size_t idx = slot(val); ; idx = (idx + 1) & mask) {
+				const std::uint32_t pos = m_table[idx];
+				if (pos == 0) {
+					m_values.push_back(val);
+					m_table[idx] = static_cast<std::uint32_t>(m_values.size());
+					return true;
+				}
+				if (m_values[pos - 1] == val)
+					return false;
+			}
+		}
+
+		[[nodiscard]] std::size_t size() const
+		{
+			return m_values.size();
+		}
+
+		[[nodiscard]] std::vector<T>& values()
+		{
+			return m_values;
+		}
+
+	private:
+		[[nodiscard]] std::size_t slot(const T& val) const
+		{
+			//fibonacci hashing, std::hash of integral types is the identity on most implementations
+			return static_cast<std::size_t>((static_cast<std::uint64_t>(Hash{}(val)) * 0x9E3779B97F4A7C15ull) >> m_shift);
+		}
+
+		std::vector<T> m_values;
+		std::vector<std::uint32_t> m_table;
+		int m_shift;
+	};
+
+	template<typename C, typename T>
+	void assign_values(C& c, std::vector<T>& values)
+	{
+		if constexpr (std::is_same_v<C, std::vector<T>>)
+			c = std::move(values);
+		else if constexpr (requires { typename C::container_type; } && std::is_constructible_v<C, std::vector<T>&&>)
+			c = C(std::move(values)); //flat containers adopt the vector
+		else if constexpr (requires { c.assign(values.begin(), values.end()); })
+			c.assign(values.begin(), values.end());
+		else { //associative containers
+			c.clear();
+			c.insert(values.begin(), values.end());
+		}
+	}
+
+	template<typename T>
+	concept std_hashable = requires(const T & val) { { std::hash<T>{}(val) } -> std::convertible_to<std::size_t>; };
+}
+
+/**
+ * @brief Fills a container with `n` distinct values produced by a generator.
+ *
+ * The generator is called until `n` different values have been produced. Distinct values are
+ * collected in an open-addressing hash set; for value types without a `std::hash` specialization
+ * batches of candidates are sorted and checked against a sorted vector instead. If the generator
+ * keeps producing only already seen values for a very long time (its range is smaller than `n`)
+ * a `std::runtime_error` is thrown instead of spinning forever.
+ *
+ * @tparam C The type of the target container. It must have an `assign(first, last)` member function,
+ *         an `insert(first, last)` member function (sets) or, like `flat_set`, a constructor
+ *         taking over a `std::vector` of the values.
+ * @tparam F The type of the generator, callable with no arguments.
+ * @param c The container whose contents are replaced by the distinct values.
+ * @param n The number of distinct values.
+ * @param func The generator used to produce the values.
+ * @param sorted If `true` (the default) the values are stored in ascending order, otherwise in
+ *        the order they were first generated.
+ *
+ * @throws std::runtime_error If the generator cannot produce `n` distinct values.
+ *
+ * @example
+ * @code
+ * std::vector<std::string> names;
+ * fcs(names, 100, random_name, false); // 100 different names in random order
+ * @endcode
+ */
+
+template<typename C, typename F>
+void fcs(C& c, std::size_t n, F func, bool sorted = true)
+{
+	using value_type = typename C::value_type;
+
+	const std::size_t max_misses = 64 * (n + 16);
+	std::size_t misses = 0;
+
+	auto check_misses = [&](bool inserted) {
+		misses = inserted ? 0 : misses + 1;
+		if (misses > max_misses)
+			throw std::runtime_error{ "fcs : generator cannot produce enough distinct values!\n" };
+	};
+
+	if constexpr (detail::std_hashable<value_type>) {
+		detail::distinct_collector<value_type> dc(n);
+		while (dc.size() != n)
+			check_misses(dc.insert(func()));
+		if (sorted)
+			std::sort(dc.values().begin(), dc.values().end());
+		detail::assign_values(c, dc.values());
+	}
+	else {
+		//no std::hash: batches of candidates are checked against a sorted vector of the values seen so far
+		std::vector<value_type> values; //in the order of generation
+		std::vector<value_type> seen;
+		std::vector<value_type> batch;
+		std::vector<std::size_t> order;
+		std::vector<char> fresh;
+		values.reserve(n);
+		seen.reserve(n);
+		while (values.size() != n) {
+			const std::size_t count = std::max<std::size_t>(n - values.size(), 64);
+			batch.clear();
+			for (std::size_t i = 0; i < count; ++i)
+				batch.push_back(func());
+			order.resize(count);
+			std::iota(order.begin(), order.end(), std::size_t{ 0 });
+			std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return batch[a] < batch[b]; });
+			fresh.assign(count, 0);
+			for (std::size_t k = 0; k < count; ++k) {
+				const std::size_t i = order[k];
+				if (k != 0 && !(batch[order[k - 1]] < batch[i]))
+					continue; //repeats a candidate generated earlier in this batch
+				fresh[i] = !std::binary_search(seen.begin(), seen.end(), batch[i]);
+			}
+			const std::size_t old_size = values.size();
+			for (std::size_t i = 0; i < count && values.size() != n; ++i)
+				if (fresh[i])
+					values.push_back(batch[i]);
+			misses = values.size() != old_size ? 0 : misses + count;
+			if (misses > max_misses)
+				throw std::runtime_error{ "fcs : generator cannot produce enough distinct values!\n" };
+			seen.insert(seen.end(), values.begin() + static_cast<std::ptrdiff_t>(old_size), values.end());
+			const auto mid = seen.begin() + static_cast<std::ptrdiff_t>(old_size);
+			std::sort(mid, seen.end());
+			std::inplace_merge(seen.begin(), mid, seen.end());
+		}
+		detail::assign_values(c, sorted ? seen : values);
+	}
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief Fills a container with `n` distinct integers from the range of an `Irand` object.
+ *
+ * Since the range [min, max] is known, no value is ever generated twice:
+ * - for a dense request (the range is at most 64 times larger than `n`) the chosen values are
+ *   marked in a bitmap; when more than half of the range is requested the values to be left out
+ *   are chosen instead, so the expected number of draws is always below `2 * n`,
+ * - for a sparse request Floyd's sampling algorithm is used, which needs exactly `n` draws.
+ *
+ * @param c The container whose contents are replaced by the distinct values.
+ * @param n The number of distinct values.
+ * @param gen The `Irand` object specifying the range of the values.
+ * @param sorted If `true` (the default) the values are stored in ascending order, otherwise in
+ *        random order.
+ *
+ * @throws std::invalid_argument If `n` is greater than the size of the range.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * fcs(ivec, 50'000'000, Irand{ 0, 100'000'000 }); // sorted unique keys
+ * @endcode
+ */
+
+template<typename C>
+void fcs(C& c, std::size_t n, const Irand& gen, bool sorted = true)
+{
+	const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(gen.max()) - gen.min()) + 1;
+	if (n > range)
+		throw std::invalid_argument{ "fcs : requested more distinct values than the range contains!\n" };
+
+	auto bounded = [](std::uint64_t bound) { //uniform value in [0, bound)
+		return std::uniform_int_distribution<std::uint64_t>{ 0, bound - 1 }(urng());
+	};
+
+	std::vector<int> values;
+	values.reserve(n);
+
+	if (range <= 64 * static_cast<std::uint64_t>(n)) {
+		std::vector<std::uint64_t> bits((range + 63) / 64);
+		const bool complement = n > range / 2;
+		std::size_t count = complement ? range - n : n;
+
+		while (count) {
+			const std::uint64_t k = bounded(range);
+			std::uint64_t& word = bits[k / 64];
+			const std::uint64_t mask = std::uint64_t{ 1 } << (k % 64);
+			if (!(word & mask)) {
+				word |= mask;
+				--count;
+				if (!complement && !sorted)
+					values.push_back(static_cast<int>(gen.min() + static_cast<std::int64_t>(k)));
+			}
+		}
+
+		if (complement || sorted) {
+			const std::uint64_t tail = range % 64 ? ~std::uint64_t{ 0 } << (range % 64) : 0;
+			if (complement)
+				bits.back() |= tail;
+			for (std::size_t i = 0; i < bits.size(); ++i) {
+				for (std::uint64_t word = complement ? ~bits[i] : bits[i]; word; word &= word - 1) {
+					const std::uint64_t k = i * 64 + std::countr_zero(word);
+					values.push_back(static_cast<int>(gen.min() + static_cast<std::int64_t>(k)));
+				}
+			}
+			if (!sorted)
+				std::shuffle(values.begin(), values.end(), urng());
+		}
+	}
+	else {
+		detail::distinct_collector<std::uint64_t> dc(n);
+		for (std::uint64_t j = range - n; j < range; ++j)
+			if (!dc.insert(bounded(j + 1)))
+				dc.insert(j);
+
+		for (const auto k : dc.values())
+			values.push_back(static_cast<int>(gen.min() + static_cast<std::int64_t>(k)));
+		if (sorted)
+			std::sort(values.begin(), values.end());
+		else
+			std::shuffle(values.begin(), values.end(), urng());
+	}
+
+	detail::assign_values(c, values);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   flat sorted containers   */
+
+/**
+ * @brief Tag type telling a flat container that the given elements are already sorted and unique.
+ */
+struct sorted_unique_t {
+	explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace detail {
+
+	inline constexpr std::size_t cache_line_size = 64;
+
+	/**
+	 * @brief Branchless lower bound on `n` sorted elements (Khuong and Morin).
+	 *
+	 * The loop runs exactly `ceil(log2(n))` times and the comparison result selects the next base
+	 * with a conditional move instead of a branch, so there are no branch mispredictions.
+	 */
+	template<typename Iter, typename K, typename Less>
+	[[nodiscard]] Iter branchless_lower_bound(Iter first, std::size_t n, const K& key, Less less)
+	{
+		if (n == 0)
+			return first;
+		while (n > 1) {
+			const std::size_t half = n / 2;
+			first = less(first[half], key) ? first + half : first;
+			n -= half;
+		}
+		return first + less(*first, key);
+	}
+
+	/**
+	 * @brief Sorts the elements appended at `mid` and merges them with the sorted elements before it.
+	 *
+	 * Among equivalent keys the element that was present first is kept.
+	 */
+	template<typename Vec, typename Less>
+	void flat_merge(Vec& vec, std::size_t mid, Less less)
+	{
+		const auto first = vec.begin(), middle = vec.begin() + static_cast<std::ptrdiff_t>(mid);
+		if (!std::is_sorted(middle, vec.end(), less))
+			std::stable_sort(middle, vec.end(), less);
+		if (mid && middle != vec.end() && less(*middle, *std::prev(middle)))
+			std::inplace_merge(first, middle, vec.end(), less);
+		vec.erase(std::unique(first, vec.end(), [&](const auto& a, const auto& b) { return !less(a, b); }), vec.end());
+	}
+
+	/**
+	 * @brief Fills a flat container to `n` elements, generating the missing ones in bulk.
+	 */
+	template<typename Flat, typename F>
+	void rfill_flat(Flat& c, std::size_t n, F& frand)
+	{
+		std::vector<typename Flat::value_type> batch;
+		while (c.size() < n) {
+			batch.clear();
+			rfill(batch, n - c.size(), std::ref(frand));
+			c.insert(batch.begin(), batch.end());
+		}
+	}
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class flat_set
+ * @brief A set stored as a sorted `std::vector`, for dense storage and fast lookup.
+ *
+ * Bulk construction and bulk insertion sort the new elements once and merge them, instead of
+ * inserting one by one into a tree; lookups use a branchless binary search. Single insertions
+ * and erasures move the following elements, so they take linear time. The interface follows
+ * C++23 `std::flat_set`. `rfill` and `fcs` fill it directly.
+ *
+ * @example
+ * @code
+ * flat_set<int> keys;
+ * fcs(keys, 1'000'000, Irand{ 0, 100'000'000 });
+ * bool found = keys.contains(42);
+ * @endcode
+ */
+
+template<typename Key, typename Compare = std::less<Key>>
+class flat_set {
+public:
+	using key_type = Key;
+	using value_type = Key;
+	using key_compare = Compare;
+	using value_compare = Compare;
+	using container_type = std::vector<Key>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = const Key&;
+	using const_reference = const Key&;
+	using iterator = typename container_type::const_iterator;
+	using const_iterator = iterator;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = reverse_iterator;
+
+	flat_set() = default;
+
+	explicit flat_set(const Compare& comp) : m_comp{ comp } {}
+
+	/**
+	 * @brief Takes over `keys`, sorts them and removes the duplicates.
+	 */
+	explicit flat_set(container_type keys, const Compare& comp = Compare{}) : m_keys{ std::move(keys) }, m_comp{ comp }
+	{
+		detail::flat_merge(m_keys, 0, m_comp);
+	}
+
+	/**
+	 * @brief Takes over `keys`, which must be sorted and unique.
+	 */
+	flat_set(sorted_unique_t, container_type keys, const Compare& comp = Compare{}) : m_keys{ std::move(keys) }, m_comp{ comp } {}
+
+	template<std::input_iterator InIter>
+	flat_set(InIter first, InIter last, const Compare& comp = Compare{}) : flat_set(container_type(first, last), comp) {}
+
+	flat_set(std::initializer_list<Key> il, const Compare& comp = Compare{}) : flat_set(container_type(il), comp) {}
+
+	[[nodiscard]] iterator begin() const noexcept { return m_keys.begin(); }
+	[[nodiscard]] iterator end() const noexcept { return m_keys.end(); }
+	[[nodiscard]] iterator cbegin() const noexcept { return m_keys.begin(); }
+	[[nodiscard]] iterator cend() const noexcept { return m_keys.end(); }
+	[[nodiscard]] reverse_iterator rbegin() const noexcept { return reverse_iterator{ end() }; }
+	[[nodiscard]] reverse_iterator rend() const noexcept { return reverse_iterator{ begin() }; }
+
+	[[nodiscard]] bool empty() const noexcept { return m_keys.empty(); }
+	[[nodiscard]] size_type size() const noexcept { return m_keys.size(); }
+	[[nodiscard]] const Key* data() const noexcept { return m_keys.data(); }
+	[[nodiscard]] key_compare key_comp() const { return m_comp; }
+
+	void reserve(size_type n) { m_keys.reserve(n); }
+	void clear() noexcept { m_keys.clear(); }
+
+	std::pair<iterator, bool> insert(const Key& key)
+	{
+		const auto pos = lower_bound(key);
+		if (pos != end() && !m_comp(key, *pos))
+			return { pos, false };
+		return { m_keys.insert(pos, key), true };
+	}
+
+	/**
+	 * @brief Inserts `key` at `hint` if that keeps the order, otherwise like `insert(key)`.
+	 *
+	 * Appending ascending keys with `insert(end(), key)` therefore takes constant time.
+	 */
+	iterator insert(const_iterator hint, const Key& key)
+	{
+		if ((hint == begin() || m_comp(*std::prev(hint), key)) && (hint == end() || m_comp(key, *hint)))
+			return m_keys.insert(hint, key);
+		return insert(key).first;
+	}
+
+	/**
+	 * @brief Inserts a range of elements with one sort and one merge.
+	 */
+	template<std::input_iterator InIter>
+	void insert(InIter first, InIter last)
+	{
+		const std::size_t mid = m_keys.size();
+		m_keys.insert(m_keys.end(), first, last);
+		detail::flat_merge(m_keys, mid, m_comp);
+	}
+
+	/**
+	 * @brief Replaces the contents with the elements of a range, sorted and without duplicates.
+	 */
+	template<std::input_iterator InIter>
+	void assign(InIter first, InIter last)
+	{
+		m_keys.assign(first, last);
+		detail::flat_merge(m_keys, 0, m_comp);
+	}
+
+	size_type erase(const Key& key)
+	{
+		const auto pos = find(key);
+		if (pos == end())
+			return 0;
+		m_keys.erase(pos);
+		return 1;
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		return m_keys.erase(pos);
+	}
+
+	[[nodiscard]] iterator lower_bound(const Key& key) const
+	{
+		return detail::branchless_lower_bound(m_keys.begin(), m_keys.size(), key, m_comp);
+	}
+
+	[[nodiscard]] iterator upper_bound(const Key& key) const
+	{
+		return detail::branchless_lower_bound(m_keys.begin(), m_keys.size(), key, [this](const Key& elem, const Key& k) { return !m_comp(k, elem); });
+	}
+
+	[[nodiscard]] iterator find(const Key& key) const
+	{
+		const auto pos = lower_bound(key);
+		return pos != end() && !m_comp(key, *pos) ? pos : end();
+	}
+
+	[[nodiscard]] bool contains(const Key& key) const
+	{
+		return find(key) != end();
+	}
+
+	[[nodiscard]] size_type count(const Key& key) const
+	{
+		return contains(key);
+	}
+
+	/**
+	 * @brief Moves the underlying vector out of the set, which becomes empty.
+	 */
+	[[nodiscard]] container_type extract() &&
+	{
+		return std::exchange(m_keys, container_type{});
+	}
+
+	/**
+	 * @brief Replaces the underlying vector with `keys`, which must be sorted and unique.
+	 */
+	void replace(container_type&& keys)
+	{
+		m_keys = std::move(keys);
+	}
+
+	friend bool operator==(const flat_set& a, const flat_set& b)
+	{
+		return a.m_keys == b.m_keys;
+	}
+
+private:
+	container_type m_keys;
+	[[no_unique_address]] Compare m_comp;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class flat_map
+ * @brief A map stored as a sorted `std::vector` of key-value pairs.
+ *
+ * Unlike C++23 `std::flat_map`, keys and values are stored together, so the iterators are plain
+ * vector iterators to `std::pair<Key, T>`. The key of an element must not be modified through them.
+ * Bulk construction and insertion sort once and merge, lookups use a branchless binary search.
+ *
+ * @example
+ * @code
+ * flat_map<int, std::string> ids;
+ * rfill(ids, 100'000, [] { return std::pair{ Irand{ 0, 1'000'000 }(), random_name() }; });
+ * @endcode
+ */
+
+template<typename Key, typename T, typename Compare = std::less<Key>>
+class flat_map {
+public:
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<Key, T>;
+	using key_compare = Compare;
+	using container_type = std::vector<value_type>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using iterator = typename container_type::iterator;
+	using const_iterator = typename container_type::const_iterator;
+
+	flat_map() = default;
+
+	explicit flat_map(const Compare& comp) : m_comp{ comp } {}
+
+	/**
+	 * @brief Takes over `elems`, sorts them by key and keeps the first element of every key.
+	 */
+	explicit flat_map(container_type elems, const Compare& comp = Compare{}) : m_elems{ std::move(elems) }, m_comp{ comp }
+	{
+		detail::flat_merge(m_elems, 0, value_less());
+	}
+
+	flat_map(sorted_unique_t, container_type elems, const Compare& comp = Compare{}) : m_elems{ std::move(elems) }, m_comp{ comp } {}
+
+	template<std::input_iterator InIter>
+	flat_map(InIter first, InIter last, const Compare& comp = Compare{}) : flat_map(container_type(first, last), comp) {}
+
+	flat_map(std::initializer_list<value_type> il, const Compare& comp = Compare{}) : flat_map(container_type(il), comp) {}
+
+	[[nodiscard]] iterator begin() noexcept { return m_elems.begin(); }
+	[[nodiscard]] iterator end() noexcept { return m_elems.end(); }
+	[[nodiscard]] const_iterator begin() const noexcept { return m_elems.begin(); }
+	[[nodiscard]] const_iterator end() const noexcept { return m_elems.end(); }
+	[[nodiscard]] const_iterator cbegin() const noexcept { return m_elems.begin(); }
+	[[nodiscard]] const_iterator cend() const noexcept { return m_elems.end(); }
+
+	[[nodiscard]] bool empty() const noexcept { return m_elems.empty(); }
+	[[nodiscard]] size_type size() const noexcept { return m_elems.size(); }
+	[[nodiscard]] key_compare key_comp() const { return m_comp; }
+
+	void reserve(size_type n) { m_elems.reserve(n); }
+	void clear() noexcept { m_elems.clear(); }
+
+	std::pair<iterator, bool> insert(const value_type& val)
+	{
+		const auto pos = lower_bound(val.first);
+		if (pos != end() && !m_comp(val.first, pos->first))
+			return { pos, false };
+		return { m_elems.insert(pos, val), true };
+	}
+
+	iterator insert(const_iterator hint, const value_type& val)
+	{
+		if ((hint == cbegin() || m_comp(std::prev(hint)->first, val.first)) && (hint == cend() || m_comp(val.first, hint->first)))
+			return m_elems.insert(hint, val);
+		return insert(val).first;
+	}
+
+	/**
+	 * @brief Inserts a range of elements with one sort and one merge; existing keys are kept.
+	 */
+	template<std::input_iterator InIter>
+	void insert(InIter first, InIter last)
+	{
+		const std::size_t mid = m_elems.size();
+		m_elems.insert(m_elems.end(), first, last);
+		detail::flat_merge(m_elems, mid, value_less());
+	}
+
+	std::pair<iterator, bool> insert_or_assign(const Key& key, T val)
+	{
+		const auto pos = lower_bound(key);
+		if (pos != end() && !m_comp(key, pos->first)) {
+			pos->second = std::move(val);
+			return { pos, false };
+		}
+		return { m_elems.emplace(pos, key, std::move(val)), true };
+	}
+
+	T& operator[](const Key& key)
+	{
+		auto pos = lower_bound(key);
+		if (pos == end() || m_comp(key, pos->first))
+			pos = m_elems.emplace(pos, key, T{});
+		return pos->second;
+	}
+
+	[[nodiscard]] T& at(const Key& key)
+	{
+		const auto pos = find(key);
+		if (pos == end())
+			throw std::out_of_range{ "flat_map : key not found!\n" };
+		return pos->second;
+	}
+
+	[[nodiscard]] const T& at(const Key& key) const
+	{
+		const auto pos = find(key);
+		if (pos == end())
+			throw std::out_of_range{ "flat_map : key not found!\n" };
+		return pos->second;
+	}
+
+	size_type erase(const Key& key)
+	{
+		const auto pos = find(key);
+		if (pos == end())
+			return 0;
+		m_elems.erase(pos);
+		return 1;
+	}
+
+	iterator erase(const_iterator pos)
+	{
+		return m_elems.erase(pos);
+	}
+
+	[[nodiscard]] iterator lower_bound(const Key& key)
+	{
+		return detail::branchless_lower_bound(m_elems.begin(), m_elems.size(), key, key_less());
+	}
+
+	[[nodiscard]] const_iterator lower_bound(const Key& key) const
+	{
+		return detail::branchless_lower_bound(m_elems.cbegin(), m_elems.size(), key, key_less());
+	}
+
+	[[nodiscard]] const_iterator upper_bound(const Key& key) const
+	{
+		return detail::branchless_lower_bound(m_elems.cbegin(), m_elems.size(), key,
+			[this](const value_type& elem, const Key& k) { return !m_comp(k, elem.first); });
+	}
+
+	[[nodiscard]] iterator find(const Key& key)
+	{
+		const auto pos = lower_bound(key);
+		return pos != end() && !m_comp(key, pos->first) ? pos : end();
+	}
+
+	[[nodiscard]] const_iterator find(const Key& key) const
+	{
+		const auto pos = lower_bound(key);
+		return pos != end() && !m_comp(key, pos->first) ? pos : end();
+	}
+
+	[[nodiscard]] bool contains(const Key& key) const
+	{
+		return find(key) != end();
+	}
+
+	[[nodiscard]] size_type count(const Key& key) const
+	{
+		return contains(key);
+	}
+
+	[[nodiscard]] container_type extract() &&
+	{
+		return std::exchange(m_elems, container_type{});
+	}
+
+	void replace(container_type&& elems)
+	{
+		m_elems = std::move(elems);
+	}
+
+	friend bool operator==(const flat_map& a, const flat_map& b)
+	{
+		return a.m_elems == b.m_elems;
+	}
+
+private:
+	[[nodiscard]] auto key_less() const
+	{
+		return [this](const value_type& elem, const Key& key) { return m_comp(elem.first, key); };
+	}
+
+	[[nodiscard]] auto value_less() const
+	{
+		return [this](const value_type& a, const value_type& b) { return m_comp(a.first, b.first); };
+	}
+
+	container_type m_elems;
+	[[no_unique_address]] Compare m_comp;
+};
+
+/**
+ * @brief Fills a `flat_set` up to `n` elements; the values are generated in bulk and merged once per round.
+ */
+template<typename Key, typename Compare, typename F>
+void rfill(flat_set<Key, Compare>& c, std::size_t n, F frand)
+{
+	detail::rfill_flat(c, n, frand);
+}
+
+/**
+ * @brief Fills a `flat_map` up to `n` elements; the pairs are generated in bulk and merged once per round.
+ */
+template<typename Key, typename T, typename Compare, typename F>
+void rfill(flat_map<Key, T, Compare>& c, std::size_t n, F frand)
+{
+	detail::rfill_flat(c, n, frand);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class eytzinger_index
+ * @brief A read-only search structure storing sorted keys in Eytzinger (breadth-first) order.
+ *
+ * The keys are laid out like the nodes of a complete binary search tree level by level, so the
+ * first levels of every search share a few cache lines, and the descent needs no branch. The
+ * cache line of the node four levels ahead is prefetched, which hides most of the memory latency
+ * for tables far larger than the cache.
+ *
+ * @example
+ * @code
+ * flat_set<int> keys;
+ * fcs(keys, 10'000'000, Irand{ 0, 1'000'000'000 });
+ * eytzinger_index<int> index{ keys };
+ * bool found = index.contains(123'456);
+ * @endcode
+ */
+
+template<typename Key, typename Compare = std::less<Key>>
+class eytzinger_index {
+public:
+	eytzinger_index() = default;
+
+	/**
+	 * @brief Builds the index from a sorted range without duplicates (e.g. a `flat_set`).
+	 */
+	template<std::ranges::random_access_range R>
+	explicit eytzinger_index(const R& sorted, const Compare& comp = Compare{}) : m_tree(std::ranges::size(sorted) + 1), m_comp{ comp }
+	{
+		std::size_t i = 0;
+		build(std::ranges::begin(sorted), i, 1);
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return m_tree.size() - 1;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return m_tree.size() <= 1;
+	}
+
+	/**
+	 * @brief Returns a pointer to the smallest key not less than `key`, `nullptr` if there is none.
+	 */
+	[[nodiscard]] const Key* lower_bound(const Key& key) const
+	{
+		constexpr std::size_t prefetch_mult = std::max<std::size_t>(1, detail::cache_line_size / sizeof(Key));
+		const std::size_t n = size();
+		const auto base = reinterpret_cast<std::uintptr_t>(m_tree.data());
+		std::size_t k = 1;
+		while (k <= n) {
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(reinterpret_cast<const void*>(base + k * prefetch_mult * sizeof(Key)));
+#endif
+			k = 2 * k + m_comp(m_tree[k], key);
+		}
+		k >>= std::countr_one(k) + 1;
+		return k ? &m_tree[k] : nullptr;
+	}
+
+	[[nodiscard]] bool contains(const Key& key) const
+	{
+		const Key* p = lower_bound(key);
+		return p && !m_comp(key, *p);
+	}
+
+private:
+	template<typename Iter>
+	void build(Iter sorted, std::size_t& i, std::size_t k)
+	{
+		if (k < m_tree.size()) {
+			build(sorted, i, 2 * k);
+			m_tree[k] = sorted[static_cast<std::ptrdiff_t>(i++)];
+			build(sorted, i, 2 * k + 1);
+		}
+	}
+
+	std::vector<Key> m_tree{ Key{} }; //1-based, m_tree[0] is unused
+	[[no_unique_address]] Compare m_comp;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+namespace detail {
+
+	/**
+	 * @brief `true` if the elements of `R` are real objects, not proxies sharing a storage word (`std::vector<bool>`).
+	 *
+	 * Only then may different threads write neighbouring elements.
+	 */
+	template<typename R>
+	concept addressable_elements = std::is_lvalue_reference_v<std::ranges::range_reference_t<R>>;
+
+	/**
+	 * @brief Runs `task(index, first, last)` for `parts` equal slices of [first, last) on separate threads.
+	 *
+	 * Slice 0 runs on the calling thread. The first exception thrown by a task is rethrown
+	 * after all threads have been joined. With `concurrent == false` all slices run one after
+	 * the other on the calling thread, with the same bounds.
+	 */
+	template<typename Task>
+	void run_chunks(std::size_t first, std::size_t last, unsigned parts, Task task, bool concurrent = true)
+	{
+		const std::size_t count = last - first;
+		parts = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(parts, count)));
+
+		std::vector<std::exception_ptr> errors(parts);
+		auto run = [&](unsigned idx) {
+			try {
+				task(idx, first + count * idx / parts, first + count * (idx + 1) / parts);
+			}
+			catch (...) {
+				errors[idx] = std::current_exception();
+			}
+		};
+
+		if (concurrent) {
+			std::vector<std::thread> workers;
+			workers.reserve(parts - 1);
+			for (unsigned idx = 1; idx < parts; ++idx)
+				workers.emplace_back(run, idx);
+			run(0);
+			for (auto& t : workers)
+				t.join();
+		}
+		else {
+			for (unsigned idx = 0; idx < parts; ++idx)
+				run(idx);
+		}
+
+		for (const auto& e : errors)
+			if (e)
+				std::rethrow_exception(e);
+	}
+
+	/**
+	 * @brief The seed of the engine of chunk `idx` when a parallel operation is seeded with `seed`.
+	 */
+	[[nodiscard]] inline std::uint64_t chunk_seed(std::uint64_t seed, std::uint64_t idx) noexcept
+	{
+		std::uint64_t state = seed ^ (idx * 0xD1B54A32D192ED03ull);
+		return splitmix64_next(state);
+	}
+
+	template<typename Dist>
+	struct seeded_bulk {
+		template<typename T>
+		void generate(T* out, std::size_t n)
+		{
+			dist.generate(out, n, eng);
+		}
+
+		Dist dist;
+		xoshiro256x4 eng;
+	};
+}
+
+/**
+ * @brief Fills a container with randomly generated elements using several threads.
+ *
+ * The container is resized to `n` elements once, the new elements are split into `threads`
+ * contiguous chunks and every chunk is filled on its own thread by the generator that
+ * `factory(chunk_index)` returns. When the factory gives every chunk an independently seeded
+ * engine (a `pcg64` stream, a jumped `xoshiro256ss`, ...), the result only depends on the seed
+ * and the number of threads, and is identical from run to run.
+ *
+ * If the generator has a bulk `generate(pointer, count)` member and the container is contiguous,
+ * the chunk is filled by a single call of that member. The elements of containers like
+ * `std::vector<bool>` are proxies sharing storage words; their chunks are filled one after the
+ * other on the calling thread, which gives the same result.
+ *
+ * @tparam Collection A random access range having `resize()` (`std::vector`, `std::deque`, `std::string`, ...).
+ * @tparam Factory A callable taking the chunk index (`std::size_t`) and returning a generator.
+ * @param c The container to be filled.
+ * @param n The size of the container after the fill.
+ * @param factory Creates the generator of each chunk.
+ * @param threads The number of threads (and chunks).
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * parallel_rfill(ivec, 100'000'000, [](std::size_t chunk) {
+ *     return [rand = Irand{ 0, 1000 }, eng = pcg64{ 42, chunk }]() mutable { return rand(eng); };
+ * });
+ * @endcode
+ */
+
+template<typename Collection, typename Factory>
+	requires std::ranges::random_access_range<Collection&> && std::invocable<Factory&, std::size_t>
+void parallel_rfill(Collection& c, std::size_t n, Factory factory, unsigned threads = std::thread::hardware_concurrency())
+{
+	const std::size_t old_size = c.size();
+	if (old_size >= n)
+		return;
+
+	c.resize(n);
+	detail::run_chunks(old_size, n, threads, [&](std::size_t idx, std::size_t first, std::size_t last) {
+		auto gen = factory(idx);
+		if constexpr (requires { gen.generate(c.data(), n); })
+			gen.generate(c.data() + first, last - first);
+		else
+			std::generate(c.begin() + first, c.begin() + last, std::ref(gen));
+	}, detail::addressable_elements<Collection&>);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/**
+ * @brief Fills a container with the bulk generator of `Irand` or `Drand` using several threads.
+ *
+ * Every chunk gets its own `xoshiro256x4` engine seeded from `seed` and the chunk index,
+ * so the result is reproducible for a given seed and number of threads.
+ *
+ * @param c The contiguous container to be filled (`std::vector<int>`, `std::vector<double>`, ...).
+ * @param n The size of the container after the fill.
+ * @param gen The distribution; it must have a `generate(pointer, count, engine)` member.
+ * @param seed The seed the chunk engines are derived from.
+ * @param threads The number of threads (and chunks).
+ *
+ * @example
+ * @code
+ * std::vector<double> dvec;
+ * parallel_rfill(dvec, 500'000'000, Drand{ 0., 1. }, 2024, 64);
+ * @endcode
+ */
+
+template<typename Collection, typename Dist>
+	requires requires(Collection& c, Dist& gen, xoshiro256x4& eng) { gen.generate(c.data(), c.size(), eng); }
+void parallel_rfill(Collection& c, std::size_t n, Dist gen, std::uint64_t seed, unsigned threads = std::thread::hardware_concurrency())
+{
+	parallel_rfill(c, n, [&](std::size_t idx) {
+		return detail::seeded_bulk<Dist>{ gen, xoshiro256x4{ detail::chunk_seed(seed, idx) } };
+	}, threads);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   shuffling and sampling   */
+
+namespace detail {
+
+	/**
+	 * @brief A uniform value in [0, range) with Lemire's nearly divisionless method.
+	 */
+	template<typename Engine>
+	[[nodiscard]] std::uint64_t bounded(std::uint64_t range, Engine& eng)
+	{
+		std::uint64_t hi;
+		std::uint64_t lo = mul128(random_u64(eng), range, hi);
+		if (lo < range) {
+			const std::uint64_t t = (0 - range) % range;
+			while (lo < t)
+				lo = mul128(random_u64(eng), range, hi);
+		}
+		return hi;
+	}
+
+	/**
+	 * @brief Two independent uniform values in [0, range1) and [0, range2) from one 64-bit draw.
+	 *
+	 * The batched form of Lemire's method (Brackett-Rozinsky and Lemire): the fractional part
+	 * left by the first multiplication is multiplied by the second range. `range1 * range2` must
+	 * not exceed 2^64.
+	 */
+	template<typename Engine>
+	void bounded_pair(std::uint64_t range1, std::uint64_t range2, std::uint64_t& r1, std::uint64_t& r2, Engine& eng)
+	{
+		const std::uint64_t product = range1 * range2;
+		std::uint64_t lo = mul128(mul128(random_u64(eng), range1, r1), range2, r2);
+		if (lo < product) {
+			const std::uint64_t t = (0 - product) % product;
+			while (lo < t)
+				lo = mul128(mul128(random_u64(eng), range1, r1), range2, r2);
+		}
+	}
+
+	inline constexpr std::size_t pair_draw_limit = std::size_t{ 1 } << 30;
+
+	template<typename Iter, typename Engine>
+	void shuffle_batched(Iter first, std::size_t n, Engine& eng)
+	{
+		using std::swap;
+		std::size_t i = n;
+		for (; i > pair_draw_limit; --i)
+			swap(first[i - 1], first[bounded(i, eng)]);
+		for (; i > 1; i -= 2) {
+			std::uint64_t j1, j2;
+			bounded_pair(i, i - 1, j1, j2, eng);
+			swap(first[i - 1], first[j1]);
+			swap(first[i - 2], first[j2]);
+		}
+	}
+
+	inline constexpr std::size_t shuffle_bucket_bytes = 256 * 1024;
+}
+
+/**
+ * @brief Shuffles a random access range (Fisher-Yates) with batched bounded draws.
+ *
+ * Every 64-bit draw of the engine gives the swap positions of two steps (Lemire's method applied
+ * twice), so there is no `std::uniform_int_distribution` and no division in the common case.
+ * All permutations are equally likely.
+ *
+ * @param r The range to be shuffled.
+ * @param eng The engine producing 32 or 64 random bits per call.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec(100'000'000);
+ * std::iota(ivec.begin(), ivec.end(), 0);
+ * shuffle_fast(ivec);
+ * @endcode
+ */
+template<std::ranges::random_access_range R, typename Engine>
+	requires std::ranges::sized_range<R>
+void shuffle_fast(R&& r, Engine& eng)
+{
+	detail::shuffle_batched(std::ranges::begin(r), static_cast<std::size_t>(std::ranges::size(r)), eng);
+}
+
+/**
+ * @brief Shuffles a random access range with the calling thread's `fast_urng()`.
+ */
+template<std::ranges::random_access_range R>
+	requires std::ranges::sized_range<R>
+void shuffle_fast(R&& r)
+{
+	shuffle_fast(r, fast_urng());
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Shuffles a large random access range using several threads and cache sized buckets.
+ *
+ * Fisher-Yates on an array much larger than the last level cache misses the cache at almost
+ * every swap. Here each thread assigns the elements of its chunk to random buckets of about
+ * 256 KiB (a scatter pass with sequential streams), then every bucket is shuffled inside the
+ * cache and the buckets are concatenated. Uniform bucket labels followed by uniform shuffles
+ * of the buckets give a uniformly distributed permutation. Small ranges are shuffled by
+ * `shuffle_fast` on the calling thread.
+ *
+ * The elements are moved to a temporary buffer, so the value type must be default constructible.
+ * The result is reproducible for a given seed and number of threads. For ranges of proxy
+ * elements (`std::vector<bool>`) the elements are written back on the calling thread.
+ *
+ * @param r The range to be shuffled.
+ * @param seed The seed the engines of the threads are derived from.
+ * @param threads The number of threads.
+ *
+ * @example
+ * @code
+ * std::vector<std::uint32_t> idx(1 << 28);
+ * std::iota(idx.begin(), idx.end(), 0u);
+ * parallel_shuffle(idx, fast_urng()());
+ * @endcode
+ */
+template<std::ranges::random_access_range R>
+	requires std::ranges::sized_range<R> && std::default_initializable<std::ranges::range_value_t<R>>
+void parallel_shuffle(R&& r, std::uint64_t seed, unsigned threads = std::thread::hardware_concurrency())
+{
+	using value_type = std::ranges::range_value_t<R>;
+	const auto first = std::ranges::begin(r);
+	const auto n = static_cast<std::size_t>(std::ranges::size(r));
+	const std::size_t buckets = std::min<std::size_t>(n * sizeof(value_type) / detail::shuffle_bucket_bytes, 0xFFFF);
+	if (buckets < 2) {
+		xoshiro256ss eng{ detail::chunk_seed(seed, 0) };
+		detail::shuffle_batched(first, n, eng);
+		return;
+	}
+
+	const unsigned parts = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, n)));
+	std::vector<std::uint16_t> labels(n);
+	std::vector<std::size_t> offsets(std::size_t{ parts } * buckets);
+	detail::run_chunks(0, n, parts, [&](unsigned p, std::size_t lo, std::size_t hi) {
+		xoshiro256ss eng{ detail::chunk_seed(seed, p) };
+		std::size_t* cnt = offsets.data() + std::size_t{ p } * buckets;
+		for (std::size_t i = lo; i < hi; ++i) {
+			const auto b = static_cast<std::uint16_t>(detail::bounded(buckets, eng));
+			labels[i] = b;
+			++cnt[b];
+		}
+	});
+
+	//bucket major, chunk minor: the elements of chunk p in bucket b follow those of chunks 0..p-1
+	std::vector<std::size_t> starts(buckets + 1);
+	std::size_t pos = 0;
+	for (std::size_t b = 0; b < buckets; ++b) {
+		starts[b] = pos;
+		for (unsigned p = 0; p < parts; ++p)
+			pos += std::exchange(offsets[p * buckets + b], pos);
+	}
+	starts[buckets] = pos;
+
+	//a plain array: unlike std::vector<bool> its elements can be written by different threads
+	const auto tmp = std::make_unique<value_type[]>(n);
+	detail::run_chunks(0, n, parts, [&](unsigned p, std::size_t lo, std::size_t hi) {
+		std::size_t* off = offsets.data() + std::size_t{ p } * buckets;
+		for (std::size_t i = lo; i < hi; ++i)
+			tmp[off[labels[i]]++] = std::move(first[i]);
+	});
+
+	//copying back to proxy elements (std::vector<bool>) runs on the calling thread, with the same result
+	detail::run_chunks(0, buckets, parts, [&](unsigned, std::size_t lo, std::size_t hi) {
+		for (std::size_t b = lo; b < hi; ++b) {
+			xoshiro256ss eng{ detail::chunk_seed(seed, parts + b) };
+			detail::shuffle_batched(tmp.get() + starts[b], starts[b + 1] - starts[b], eng);
+			std::move(tmp.get() + starts[b], tmp.get() + starts[b + 1], first + starts[b]);
+		}
+	}, detail::addressable_elements<R>);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Selects `k` elements of a range at random, each subset being equally likely.
+ *
+ * Reservoir sampling with Li's algorithm L: after the first `k` elements only the positions of
+ * the replaced elements are drawn, which costs `O(k log(n / k))` random numbers. Random access
+ * ranges of known size jump directly to these positions, other input ranges are traversed once.
+ * The selected elements are returned in random order. If the range has fewer than `k`
+ * elements, all of them are returned.
+ *
+ * @param r The range to sample from.
+ * @param k The number of elements to be selected.
+ * @param eng The engine producing 32 or 64 random bits per call.
+ * @return A vector holding the selected elements.
+ *
+ * @example
+ * @code
+ * std::list<std::string> mylist;
+ * rfill(mylist, 100'000, random_name);
+ * auto names = sample(mylist, 10);
+ * @endcode
+ */
+template<std::ranges::input_range R, typename Engine>
+[[nodiscard]] std::vector<std::ranges::range_value_t<R>> sample(R&& r, std::size_t k, Engine& eng)
+{
+	std::vector<std::ranges::range_value_t<R>> res;
+	if (k == 0)
+		return res;
+
+	auto iter = std::ranges::begin(r);
+	const auto last = std::ranges::end(r);
+	if constexpr (std::ranges::sized_range<R>)
+		res.reserve(std::min<std::size_t>(k, static_cast<std::size_t>(std::ranges::size(r))));
+	for (; iter != last && res.size() < k; ++iter)
+		res.push_back(*iter);
+
+	if (iter != last) {
+		auto unit = [&] { return detail::unit_real_open(detail::random_u64(eng)); };
+		const double inv_k = 1. / static_cast<double>(k);
+		double w = std::exp(std::log(unit()) * inv_k);
+		std::size_t remaining = 0;
+		if constexpr (std::ranges::random_access_range<R> && std::ranges::sized_range<R>)
+			remaining = static_cast<std::size_t>(last - iter);
+		for (;;) {
+			const double skip = std::floor(std::log(unit()) / std::log1p(-w));
+			if constexpr (std::ranges::random_access_range<R> && std::ranges::sized_range<R>) {
+				if (!(skip < static_cast<double>(remaining)))
+					break;
+				const auto s = static_cast<std::size_t>(skip);
+				iter += static_cast<std::ranges::range_difference_t<R>>(s);
+				remaining -= s + 1;
+			}
+			else {
+				const double limit = static_cast<double>(std::numeric_limits<std::size_t>::max());
+				for (auto s = static_cast<std::size_t>(skip < limit ? skip : limit); s && iter != last; --s)
+					++iter;
+				if (iter == last)
+					break;
+			}
+			res[detail::bounded(k, eng)] = *iter;
+			++iter;
+			w *= std::exp(std::log(unit()) * inv_k);
+		}
+	}
+	shuffle_fast(res, eng);
+	return res;
+}
+
+/**
+ * @brief Selects `k` elements of a range at random with the calling thread's `fast_urng()`.
+ */
+template<std::ranges::input_range R>
+[[nodiscard]] std::vector<std::ranges::range_value_t<R>> sample(R&& r, std::size_t k)
+{
+	return sample(r, k, fast_urng());
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns a random permutation of 0, 1, ..., n - 1.
+ *
+ * @tparam T The unsigned integer type of the indices, `std::uint32_t` by default to save cache.
+ *
+ * @example
+ * @code
+ * auto order = random_permutation(data.size()); // visit data[order[i]] in random order
+ * @endcode
+ */
+template<std::unsigned_integral T = std::uint32_t, typename Engine>
+[[nodiscard]] std::vector<T> random_permutation(std::size_t n, Engine& eng)
+{
+	if (n && n - 1 > std::numeric_limits<T>::max())
+		throw std::invalid_argument{ "random_permutation : the index type is too small!\n" };
+	std::vector<T> vec(n);
+	for (std::size_t i = 0; i < n; ++i)
+		vec[i] = static_cast<T>(i);
+	detail::shuffle_batched(vec.begin(), n, eng);
+	return vec;
+}
+
+template<std::unsigned_integral T = std::uint32_t>
+[[nodiscard]] std::vector<T> random_permutation(std::size_t n)
+{
+	return random_permutation<T>(n, fast_urng());
+}
+
+/**
+ * @brief Returns a random cyclic permutation for pointer chasing (Sattolo's algorithm).
+ *
+ * `vec[i]` is the successor of `i`, and starting from any index the successors visit all `n`
+ * indices before coming back, in an order the hardware prefetchers cannot predict. Every
+ * cyclic permutation is equally likely. Multiplying the indices by a stride lets the chain
+ * touch one element per cache line or per page.
+ *
+ * @tparam T The unsigned integer type of the indices, `std::uint32_t` by default.
+ *
+ * @example
+ * @code
+ * const auto next = random_cycle(std::size_t{ 1 } << 24); // 64 MiB of indices
+ * std::uint32_t idx = 0;
+ * benchmark("dependent loads", [&] { idx = next[idx]; do_not_optimize(idx); });
+ * @endcode
+ */
+template<std::unsigned_integral T = std::uint32_t, typename Engine>
+[[nodiscard]] std::vector<T> random_cycle(std::size_t n, Engine& eng)
+{
+	using std::swap;
+	if (n && n - 1 > std::numeric_limits<T>::max())
+		throw std::invalid_argument{ "random_cycle : the index type is too small!\n" };
+	std::vector<T> vec(n);
+	for (std::size_t i = 0; i < n; ++i)
+		vec[i] = static_cast<T>(i);
+	if (n < 2)
+		return vec;
+
+	std::size_t i = n - 1;
+	for (; i > detail::pair_draw_limit; --i)
+		swap(vec[i], vec[detail::bounded(i, eng)]);
+	for (; i > 1; i -= 2) {
+		std::uint64_t j1, j2;
+		detail::bounded_pair(i, i - 1, j1, j2, eng);
+		swap(vec[i], vec[j1]);
+		swap(vec[i - 1], vec[j2]);
+	}
+	if (i == 1)
+		swap(vec[1], vec[0]);
+	return vec;
+}
+
+template<std::unsigned_integral T = std::uint32_t>
+[[nodiscard]] std::vector<T> random_cycle(std::size_t n)
+{
+	return random_cycle<T>(n, fast_urng());
+}
+//------------------------------------------------------
+//------------------------------------------------------
+namespace detail {
+
+	inline constexpr const char* pnames[] = {
+		"abdi", "abdullah", "abdulmuttalip", "adem", "adnan", "afacan", "agah", "ahmet", "akin", "alev",
+		"ali", "alican", "alparslan", "anil", "arda", "asim", "askin", "aslican", "aslihan", "ata",
+		"atakan", "atalay", "atif", "atil", "aycan", "aydan", "aykut", "ayla", "aylin", "aynur",
+		"ayse", "aytac", "aziz", "azize", "azmi", "baran", "bekir", "belgin", "bennur", "beril",
+		"berivan", "berk", "beste", "beyhan", "bilal", "bilge", "bilgin", "billur", "binnaz", "binnur",
+		"birhan", "bora", "bulent", "burak", "burhan", "busra", "cahide", "cahit", "can", "canan",
+		"candan", "caner", "tamer", "cansu", "cebrail", "celal", "celik", "cem", "cemal", "cemil", "cemile",
+		"cemre", "cengiz", "cesim", "cetin", "ceyda", "ceyhan", "ceyhun", "ceylan", "cezmi", "cihan",
+		"cihat", "ciler", "cumhur", "cuneyt", "demet", "demir", "deniz", "derin", "derya", "devlet", "devrim", "diana",
+		"dilber", "dilek", "dogan", "dost", "durmus", "durriye", "ece", "eda", "edip", "ediz",
+		"efe", "efecan", "ege", "egemen", "emine", "emirhan", "emre", "emrecan", "enes", "engin",
+		"ercument", "erdem", "esen", "esin", "esra", "eylul", "fadime", "fahri", "fazilet", "feramuz",
+		"feraye", "ferhat", "ferhunde", "figen", "fikret", "fuat", "fugen", "furkan", "galip", "garo",
+		"gazi", "gizem", "gul", "gulden", "gulsah", "gulsen", "gunay", "gurbuz", "gursel", "hakan",
+		"hakki", "haldun", "halime", "haluk", "handan", "hande", "handesu", "hasan", "helin", "hikmet",
+		"hilal", "hilmi", "hulki", "hulusi", "hulya", "huseyin", "iffet", "irmak", "ismail", "izzet",
+		"jade", "julide", "kaan", "kamil", "kamile", "kasim", "kaya", "kayahan", "kayhan", "kazim",
+		"kelami", "kenan", "kerem", "kerim", "keriman", "kezban", "korhan", "kunter", "kurthan", "lale",
+		"lamia", "leyla", "mahir", "malik", "mehmet", "melek", "melih", "melike", "melisa", "menekse", "mert",
+		"metin", "mucahit", "muhsin", "mukerrem", "murat", "murathan", "muruvvet", "muslum", "mustafa", "muzaffer", "naci", "naciye",
+		"nagehan", "nahit", "nalan", "nasrullah", "naz", "nazif", "nazife", "nazli", "necmettin", "necmi",
+		"necmiye", "nedim", "nefes", "nevsin", "nihal", "nihat", "nisan", "niyazi", "nurdan", "nuri",
+		"nuriye", "nurullah", "nusret", "okan", "olcay", "onat", "orkun", "osman", "pakize", "papatya",
+		"pelin", "pelinsu", "perihan", "petek", "pinat", "polat", "polathan", "poyraz", "recep", "refik",
+		"refika", "rumeysa", "rupen", "saadet", "sabriye", "sade", "sadegul", "sadettin", "sadi", "sadiye",
+		"sadri", "sadullah", "samet", "sami", "saniye", "sarp", "sefa", "sefer", "selenay", "selin",
+		"semsit", "sevda", "sevilay", "sevim", "seyhan", "sezai", "sezen", "sezer", "sidre", "sinem",
+		"soner", "su", "suheyla", "suleyman", "sumeyye", "suphi", "taci", "taner", "tanju", "tansel",
+		"tansu", "tarcan", "tarik", "tarkan", "tayfun", "tayyar", "tayyip", "tekin", "temel", "teoman",
+		"teslime", "tevfik", "tijen", "tonguc", "tufan", "tugay", "tugra", "tunc", "tuncer", "turgut",
+		"turhan", "ufuk", "ugur", "umit", "utku", "yalcin", "yasar", "yasemin", "yasin", "emrecan",
+		"yavuz", "yelda", "yeliz", "yesim", "yilmaz", "yunus", "yurdagul", "yurdakul", "yurdanur", "yusuf",
+		"zahide", "zahit", "zarife", "zekai", "necati", "zeliha", "zerrin", "ziya", "zubeyde",
+	};
+
+	inline constexpr const char* pfnames[] = {
+		"acar", "acgoze", "acuka", "ademoglu", "adiguzel", "agaoglu", "akarsu", "akcalar", "akgunes", "akkay",
+		"akkuyu", "aklikit", "aksakal", "akyildiz", "akyoldas", "alemdar", "alniacik", "altindag", "altinisik", "altinorak",
+		"arcan", "aslan", "avci", "aybeyaz", "aylak", "azmak", "bahceli", "bakirci", "baklavaci", "barutcu",
+		"baturalp", "bayraktar", "bekar", "belgeli", "beyaz", "bilgic", "bozkaya", "boztas", "canbay", "candamar",
+		"cangoz", "cankoc", "canlikaya", "cansever", "cansiz", "celik", "celiker", "cengaver", "cevikkol", "cilingir",
+		"comakci", "corbaci", "cubukay", "cuhadar", "daglarca", "damar", "degirmenci", "demirdogen", "demirel", "derin",
+		"dingin", "dokmeci", "dokuzcan", "dosteli", "dumbuk", "dunyalik", "ecevit", "edepli", "edepsiz", "efelik",
+		"elebasi", "eliagir", "elibol", "elitemiz", "elkizi", "elmali", "eloglu", "emirkulu", "engerek", "engereke",
+		"erdogan", "ergin", "erim", "ersoy", "ertakan", "esbereli", "esnedur", "esteberli", "etci", "ezergecer",
+		"fakir", "fedai", "fincan", "firatonu", "fitrat", "gamsiz", "gedik", "geldik", "gilgamis", "girik",
+		"girit", "gucsuz", "gultekin", "gumus", "gurkas", "hamsikoylu", "harmanci", "haselici", "hepguler", "hurmaci",
+		"iliksiz", "issiz", "jilet", "kabasakal", "kadersiz", "kahraman", "kalemsiz", "kalinkas", "kalpsiz", "kalpten",
+		"kapan", "kapici", "kaplan", "kara", "karabatur", "karaduman", "karaelmas", "karakis", "karakoyun", "karakuzu",
+		"karamuk", "karaorman", "karasaban", "karataban", "karayel", "kayabasi", "kazanci", "kecisakal", "kelepce", "kelleci",
+		"keskin", "kesman", "kilicdar", "kilimci", "kilinc", "kirboga", "kirci", "kocyigit", "kolcak", "komcu",
+		"komurcu", "konak", "konca", "koralp", "korukcu", "kosnuk", "kotek", "koylu", "kucukkaya", "kulaksiz",
+		"kurban", "kurtulus", "kusmen", "lalezar", "lokmaci", "lombak", "lufer", "maganda", "malazgirt", "malkaciran",
+		"mazgirt", "merdane", "mertek", "merzifon", "mirza", "miskin", "miskinoglu", "muglali", "nazik", "nurtopu",
+		"olmez", "oltu", "onaran", "ongun", "ordulu", "orhancan", "ormanci", "ortaca", "osmaneli", "otaci",
+		"ovacik", "oztoklu", "ozvezneci", "pakdamar", "pirlanta", "polatkan", "portakal", "poturgeli", "reis", "renacan",
+		"resimci", "saferikli", "safkan", "salca", "saldiray", "sallabas", "samanci", "saricakir", "sarikafa", "sarpdemir",
+		"savaskan", "sefiloglu", "selercan", "semiz", "sener", "serce", "serinsun", "sessiz", "silahdar", "silifkeli",
+		"simsek", "sivri", "sofuoglu", "sonmez", "sonuzun", "soylu", "soysalan", "soyubozuk", "sucu", "sulugoz",
+		"supuren", "takes", "tamgun", "tamirci", "tantana", "tarumar", "tekinalp", "tekkaya", "tekkilic", "telek",
+		"temiz", "temizel", "temizkalp", "tepecik", "tepsici", "tercan", "terlemez", "tertemiz", "tilki", "tokatci",
+		"tombeki", "topatan", "topkapi", "tozkoporan", "tufancan", "tunali", "tuzcu", "tuztas", "ufurukcu", "ugursuz",
+		"ulakci", "uluocak", "umutsuz", "unalan", "unalmis", "unkapani", "uraz", "uslu", "uyar", "uzay",
 		"uzunadam", "yagizeli", "yanardag", "yanardoner", "yangin", "yaracan", "yaradan", "yarma", "yasayavas", "yasli",
 		"yasmak", "yavas", "yavasakan", "yaygara", "yelden", "yeldirme", "yeldirmen", "yersiz", "yikilmaz", "yildirim",
 		"yilgin", "yilmaz", "yolyapan", "yorganci", "yorgun", "yosun", "yurdakul", "yurekli", "yurekyakan", "yurtsuz",
 		"zaimoglu", "zalim", "zengin", "zebani"
 	};
 
-	return pfnames[Irand(0, (int)(std::size(pfnames)) - 1)()];
+	/**
+	 * @brief Compile-time copy of a list of C-strings as one contiguous character blob plus offsets.
+	 */
+	template<const auto& List>
+	class string_table {
+	public:
+		static constexpr std::size_t count = std::size(List);
+
+		[[nodiscard]] static constexpr std::string_view get(std::size_t idx) noexcept
+		{
+			return { chars.data() + offsets[idx], offsets[idx + 1] - offsets[idx] };
+		}
+
+		/**
+		 * @brief Returns the index distribution of the table, created once per thread.
+		 */
+		[[nodiscard]] static Irand& index_generator()
+		{
+			thread_local Irand rand{ 0, static_cast<int>(count) - 1 };
+			return rand;
+		}
+
+		[[nodiscard]] static std::string_view random()
+		{
+			return get(static_cast<std::size_t>(index_generator()()));
+		}
+
+	private:
+		static constexpr std::size_t total = [] {
+			std::size_t len = 0;
+			for (const char* p : List)
+				len += std::char_traits<char>::length(p);
+			return len;
+		}();
+
+		static constexpr auto offsets = [] {
+			std::array<std::uint32_t, count + 1> offs{};
+			for (std::size_t i = 0; i < count; ++i)
+				offs[i + 1] = offs[i] + static_cast<std::uint32_t>(std::char_traits<char>::length(List[i]));
+			return offs;
+		}();
+
+		static constexpr auto chars = [] {
+			std::array<char, total> blob{};
+			std::size_t pos = 0;
+			for (const char* p : List)
+				while (*p)
+					blob[pos++] = *p++;
+			return blob;
+		}();
+	};
+
+	using name_table = string_table<pnames>;
+	using surname_table = string_table<pfnames>;
+
+	template<typename Table>
+	void random_views(std::span<std::string_view> out)
+	{
+		int idx[batch_size];
+		while (!out.empty()) {
+			const std::size_t cnt = std::min(out.size(), batch_size);
+			Table::index_generator().generate(idx, cnt);
+			for (std::size_t i = 0; i < cnt; ++i)
+				out[i] = Table::get(static_cast<std::size_t>(idx[i]));
+			out = out.subspan(cnt);
+		}
+	}
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns a random name from the predefined list of names without allocating.
+ *
+ * @return A view of the selected name, which refers to static storage.
+ */
+[[nodiscard]] inline std::string_view random_name_sv()
+{
+	return detail::name_table::random();
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns a random surname from the predefined list of surnames without allocating.
+ *
+ * @return A view of the selected surname, which refers to static storage.
+ */
+[[nodiscard]] inline std::string_view random_surname_sv()
+{
+	return detail::surname_table::random();
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Generates a random name from a predefined list of names.
+ *
+ * This inline function returns a randomly selected name from a predefined list of names.
+ * The names are stored in a static array, and a random index is used to select one name.
+ * Use `random_name_sv` to avoid the construction of a `std::string`.
+ *
+ * @return A `std::string` containing the randomly selected name.
+ *
+ * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+ *
+ * @example
+ * @code
+ * std::string name = random_name(); // Generates a random name from the list.
+ * std::cout << "Random Name: " << name << std::endl;
+ * @endcode
+ */
+inline [[nodiscard]] std::string random_name()
+{
+	return std::string{ random_name_sv() };
+}
+//--------------------------------------------------
+//--------------------------------------------------
+/**
+ * @brief Generates a random surname from a predefined list of surnames.
+ *
+ * This inline function returns a randomly selected surname from a predefined list of surnames.
+ * The surnames are stored in a static array, and a random index is used to select one surname.
+ * Use `random_surname_sv` to avoid the construction of a `std::string`.
+ *
+ * @return A `std::string` containing the randomly selected surname.
+ *
+ * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+ *
+ * @example
+ * @code
+ * std::string surname = random_surname(); // Generates a random surname from the list.
+ * std::cout << "Random Surname: " << surname << std::endl;
+ * @endcode
+ */
+inline [[nodiscard]] std::string random_surname()
+{
+	return std::string{ random_surname_sv() };
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Fills `out` with random names.
+ *
+ * The indices are produced by the bulk generator of `Irand`, so filling millions of
+ * `std::string_view` handles costs a few nanoseconds per name and allocates nothing.
+ *
+ * @param out The views to be written; they refer to static storage.
+ *
+ * @example
+ * @code
+ * std::vector<std::string_view> names(10'000'000);
+ * random_names(names);
+ * @endcode
+ */
+inline void random_names(std::span<std::string_view> out)
+{
+	detail::random_views<detail::name_table>(out);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Fills `out` with random surnames.
+ *
+ * @param out The views to be written; they refer to static storage.
+ */
+inline void random_surnames(std::span<std::string_view> out)
+{
+	detail::random_views<detail::surname_table>(out);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief A name generator with a bulk `generate` member, e.g. for `record_generator` columns.
+ *
+ * `Namerand{}()` is `random_name_sv()`, `generate(p, n)` is `random_names` on `n` views at `p`.
+ */
+struct Namerand {
+	[[nodiscard]] std::string_view operator()() const
+	{
+		return random_name_sv();
+	}
+
+	void generate(std::string_view* p, std::size_t n) const
+	{
+		random_names({ p, n });
+	}
+};
+
+/**
+ * @brief A surname generator with a bulk `generate` member, e.g. for `record_generator` columns.
+ *
+ * `Surnamerand{}()` is `random_surname_sv()`, `generate(p, n)` is `random_surnames` on `n` views at `p`.
+ */
+struct Surnamerand {
+	[[nodiscard]] std::string_view operator()() const
+	{
+		return random_surname_sv();
+	}
+
+	void generate(std::string_view* p, std::size_t n) const
+	{
+		random_surnames({ p, n });
+	}
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   random strings and bytes   */
+
+inline constexpr std::string_view alnum_chars = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+inline constexpr std::string_view lower_chars = "abcdefghijklmnopqrstuvwxyz";
+inline constexpr std::string_view upper_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+inline constexpr std::string_view digit_chars = "0123456789";
+inline constexpr std::string_view hex_chars = "0123456789abcdef";
+
+namespace detail {
+
+	/**
+	 * @brief Writes `n` characters chosen from `alphabet` into `out`.
+	 *
+	 * Several characters are taken from every 64-bit draw. For alphabets whose size is a power of
+	 * two they are bit fields, otherwise the draw is used as a fraction and multiplied by the
+	 * alphabet size once per character (the integer part is the index, the fractional part goes on).
+	 * A draw is abandoned while at least 20 bits are left, so the deviation from the uniform
+	 * distribution stays below one part in a million.
+	 */
+	template<typename Engine>
+	void random_chars(char* out, std::size_t n, std::string_view alphabet, Engine& eng)
+	{
+		const std::uint64_t k = alphabet.size();
+		if (k == 0)
+			throw std::invalid_argument{ "random_chars : the alphabet cannot be empty!\n" };
+		if (k == 1) {
+			std::memset(out, alphabet[0], n);
+			return;
+		}
+
+		const char* const chars = alphabet.data();
+		std::uint64_t buf[batch_size];
+		if (std::has_single_bit(k)) {
+			const int bits = std::countr_zero(k);
+			const std::size_t per_draw = static_cast<std::size_t>(64 / bits);
+			while (n) {
+				const std::size_t draws = std::min(batch_size, (n + per_draw - 1) / per_draw);
+				fill_bits(eng, buf, draws);
+				for (std::size_t i = 0; i < draws && n; ++i) {
+					std::uint64_t x = buf[i];
+					for (std::size_t j = 0; j < per_draw && n; ++j, --n) {
+						*out++ = chars[x & (k - 1)];
+						x >>= bits;
+					}
+				}
+			}
+		}
+		else {
+			const std::size_t per_draw = std::max<std::size_t>(1, static_cast<std::size_t>(44 / std::log2(static_cast<double>(k))));
+			while (n) {
+				const std::size_t draws = std::min(batch_size, (n + per_draw - 1) / per_draw);
+				fill_bits(eng, buf, draws);
+				for (std::size_t i = 0; i < draws && n; ++i) {
+					std::uint64_t x = buf[i];
+					for (std::size_t j = 0; j < per_draw && n; ++j, --n) {
+						std::uint64_t idx;
+						x = mul128(x, k, idx);
+						*out++ = chars[idx];
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Returns a random string of `len` characters chosen from `alphabet`.
+ *
+ * @param len The length of the string.
+ * @param alphabet The characters that may appear, each with the same probability. The default is `alnum_chars`.
+ *
+ * @example
+ * @code
+ * std::string key = random_string(16);
+ * std::string hex = random_string(32, hex_chars);
+ * @endcode
+ */
+[[nodiscard]] inline std::string random_string(std::size_t len, std::string_view alphabet = alnum_chars)
+{
+	std::string s(len, '\0');
+	detail::random_chars(s.data(), len, alphabet, fast_urng());
+	return s;
+}
+
+/**
+ * @brief Fills `out` with random bytes, 64 bits per engine call.
+ *
+ * @param out The bytes to be written.
+ * @param eng The engine, `batch_urng()` by default.
+ */
+template<typename Engine>
+void random_bytes(std::span<std::byte> out, Engine& eng)
+{
+	std::uint64_t buf[detail::batch_size];
+	auto p = out.data();
+	std::size_t n = out.size();
+	while (n) {
+		const std::size_t cnt = std::min(n, sizeof buf);
+		detail::fill_bits(eng, buf, (cnt + 7) / 8);
+		std::memcpy(p, buf, cnt);
+		p += cnt;
+		n -= cnt;
+	}
+}
+
+inline void random_bytes(std::span<std::byte> out)
+{
+	random_bytes(out, batch_urng());
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class string_arena
+ * @brief Strings stored back to back in one buffer and accessed through `std::string_view` handles.
+ *
+ * A `string_arena` makes two allocations however many strings it holds. The views remain valid
+ * as long as the arena exists, also after it has been moved. A copy has its own buffer and views.
+ */
+
+class string_arena {
+public:
+	string_arena() = default;
+
+	/**
+	 * @brief Copies the characters and points the views of the copy into its own buffer.
+	 */
+	string_arena(const string_arena& other) : m_chars{ other.m_chars }
+	{
+		m_views.reserve(other.m_views.size());
+		for (std::string_view sv : other.m_views)
+			m_views.emplace_back(m_chars.data() + (sv.data() - other.m_chars.data()), sv.size());
+	}
+
+	string_arena(string_arena&&) noexcept = default;
+
+	string_arena& operator=(const string_arena& other)
+	{
+		if (this != &other)
+			*this = string_arena(other);
+		return *this;
+	}
+
+	string_arena& operator=(string_arena&&) noexcept = default;
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return m_views.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return m_views.empty();
+	}
+
+	[[nodiscard]] std::string_view operator[](std::size_t idx) const noexcept
+	{
+		return m_views[idx];
+	}
+
+	[[nodiscard]] auto begin() const noexcept
+	{
+		return m_views.cbegin();
+	}
+
+	[[nodiscard]] auto end() const noexcept
+	{
+		return m_views.cend();
+	}
+
+	[[nodiscard]] std::span<const std::string_view> views() const noexcept
+	{
+		return m_views;
+	}
+
+	/**
+	 * @brief Returns the total number of characters stored.
+	 */
+	[[nodiscard]] std::size_t bytes() const noexcept
+	{
+		return m_chars.size();
+	}
+
+private:
+	friend string_arena random_strings(std::size_t n, std::size_t min_len, std::size_t max_len, std::string_view alphabet);
+
+	std::vector<char> m_chars;
+	std::vector<std::string_view> m_views;
+};
+
+/**
+ * @brief Generates `n` random strings with uniformly distributed lengths in [min_len, max_len].
+ *
+ * The lengths are generated first, then all characters are produced by one bulk pass into a
+ * single buffer, which is cut into views.
+ *
+ * @param n The number of strings.
+ * @param min_len The minimum length.
+ * @param max_len The maximum length.
+ * @param alphabet The characters that may appear. The default is `alnum_chars`.
+ * @return A `string_arena` holding the strings.
+ *
+ * @example
+ * @code
+ * auto keys = random_strings(1'000'000, 8, 24);
+ * std::unordered_set<std::string_view> myset(keys.begin(), keys.end());
+ * @endcode
+ */
+[[nodiscard]] inline string_arena random_strings(std::size_t n, std::size_t min_len, std::size_t max_len, std::string_view alphabet = alnum_chars)
+{
+	if (min_len > max_len || max_len > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+		throw std::invalid_argument{ "random_strings : invalid length range!\n" };
+
+	string_arena arena;
+	std::vector<int> lens(n);
+	detail::generate_int(static_cast<int>(min_len), static_cast<int>(max_len), lens.data(), n, batch_urng());
+	std::size_t total = 0;
+	for (int len : lens)
+		total += static_cast<std::size_t>(len);
+
+	arena.m_chars.resize(total);
+	detail::random_chars(arena.m_chars.data(), total, alphabet, batch_urng());
+	arena.m_views.reserve(n);
+	const char* p = arena.m_chars.data();
+	for (int len : lens) {
+		arena.m_views.emplace_back(p, static_cast<std::size_t>(len));
+		p += len;
+	}
+	return arena;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief A named column of a record schema and the generator producing its values.
+ *
+ * @tparam Gen A type callable with no arguments (`Irand`, `Drand`, `Namerand`, a lambda, ...).
+ */
+template<typename Gen>
+struct column {
+	using value_type = std::remove_cvref_t<std::invoke_result_t<Gen&>>;
+
+	std::string_view name;
+	Gen gen;
+};
+
+template<typename Gen>
+column(std::string_view, Gen) -> column<Gen>;
+
+namespace detail {
+
+	template<typename T, typename Gen>
+	void fill_column(std::vector<T>& vec, std::size_t n, Gen& gen)
+	{
+		vec.resize(n);
+		if constexpr (requires { gen.generate(vec.data(), n); }) {
+			gen.generate(vec.data(), n);
+		}
+		else {
+			std::generate(vec.begin(), vec.end(), std::ref(gen));
+		}
+	}
+}
+
+/**
+ * @class record_generator
+ * @brief Generates synthetic records column by column from a schema.
+ *
+ * Every column of the schema has its own generator. Records are produced either as a
+ * struct of arrays (one contiguous `std::vector` per column) or as an array of structs
+ * (`std::vector<Record>` of a user supplied aggregate whose members follow the column order).
+ * Columns whose generator has a bulk `generate(pointer, count)` member (`Irand`, `Drand`,
+ * `Namerand`, `Surnamerand`) are filled by that member. The streaming functions produce the
+ * records in batches of fixed size that reuse the same storage, so data sets larger than memory
+ * can be written out piece by piece.
+ *
+ * @example
+ * @code
+ * record_generator gen{
+ *     column{ "id", Irand{ 0, 1'000'000 } },
+ *     column{ "name", Namerand{} },
+ *     column{ "surname", Surnamerand{} },
+ *     column{ "salary", Drand{ 10'000., 100'000. } },
+ * };
+ *
+ * auto [ids, names, surnames, salaries] = gen.generate_soa(10'000'000);
+ *
+ * struct Person { int id; std::string_view name, surname; double salary; };
+ * std::vector<Person> persons = gen.generate_aos<Person>(1'000'000);
+ *
+ * gen.stream(1'000'000'000, 1 << 20, [&](const auto& batch) { save(std::get<0>(batch)); });
+ * @endcode
+ */
+
+template<typename... Gens>
+class record_generator {
+public:
+	/**
+	 * @brief Struct of arrays holding a batch of records, one vector per column.
+	 */
+	using batch_type = std::tuple<std::vector<typename column<Gens>::value_type>...>;
+
+	static constexpr std::size_t column_count = sizeof...(Gens);
+
+	explicit record_generator(column<Gens>... cols) : m_cols{ std::move(cols)... } {}
+
+	/**
+	 * @brief Returns the column names in schema order.
+	 */
+	[[nodiscard]] std::array<std::string_view, column_count> names() const
+	{
+		return std::apply([](const auto&... col) { return std::array<std::string_view, column_count>{ col.name... }; }, m_cols);
+	}
+
+	/**
+	 * @brief Replaces the contents of `batch` with `n` new records.
+	 */
+	void fill(batch_type& batch, std::size_t n)
+	{
+		fill(batch, n, std::index_sequence_for<Gens...>{});
+	}
+
+	/**
+	 * @brief Returns `n` new records as a struct of arrays.
+	 */
+	[[nodiscard]] batch_type generate_soa(std::size_t n)
+	{
+		batch_type batch;
+		fill(batch, n);
+		return batch;
+	}
+
+	/**
+	 * @brief Returns `n` new records as an array of structs.
+	 *
+	 * @tparam Record An aggregate that can be initialized from the column values in schema order.
+	 */
+	template<typename Record>
+	[[nodiscard]] std::vector<Record> generate_aos(std::size_t n)
+	{
+		std::vector<Record> records;
+		records.reserve(n);
+		stream_aos<Record>(n, aos_batch_size, [&](std::span<Record> batch) {
+			records.insert(records.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+		});
+		return records;
+	}
+
+	/**
+	 * @brief Produces `total` records in batches of `batch_size` as structs of arrays.
+	 *
+	 * @param f Called with a `batch_type&` for every batch; the last batch may be smaller.
+	 *        The storage of the batch is reused by the next call.
+	 */
+	template<typename F>
+	void stream(std::size_t total, std::size_t batch_size, F f)
+	{
+		batch_type batch;
+		for (std::size_t done = 0; done < total; ) {
+			const std::size_t cnt = std::min(batch_size, total - done);
+			fill(batch, cnt);
+			f(batch);
+			done += cnt;
+		}
+	}
+
+	/**
+	 * @brief Produces `total` records in batches of `batch_size` as arrays of structs.
+	 *
+	 * @param f Called with a `std::span<Record>` for every batch; the last batch may be smaller.
+	 */
+	template<typename Record, typename F>
+	void stream_aos(std::size_t total, std::size_t batch_size, F f)
+	{
+		std::vector<Record> records;
+		stream(total, batch_size, [&](batch_type& batch) {
+			records.clear();
+			to_records(batch, records, std::index_sequence_for<Gens...>{});
+			f(std::span<Record>{ records });
+		});
+	}
+
+private:
+	static constexpr std::size_t aos_batch_size = 4096;
+
+	template<std::size_t... I>
+	void fill(batch_type& batch, std::size_t n, std::index_sequence<I...>)
+	{
+		(detail::fill_column(std::get<I>(batch), n, std::get<I>(m_cols).gen), ...);
+	}
+
+	template<typename Record, std::size_t... I>
+	static void to_records(batch_type& batch, std::vector<Record>& records, std::index_sequence<I...>)
+	{
+		const std::size_t n = std::get<0>(batch).size();
+		for (std::size_t k = 0; k < n; ++k)
+			records.push_back(Record{ std::move(std::get<I>(batch)[k])... });
+	}
+
+	std::tuple<column<Gens>...> m_cols;
+};
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Determines if a given integer is a prime number.
+ *
+ * This `constexpr` function checks whether a given integer is a prime number.
+ * A prime number is a natural number greater than 1 that is not divisible by any
+ * number other than 1 and itself. The function optimizes the check by initially
+ * handling small divisors and then only testing odd numbers up to the square root of the input.
+ *
+ * @param val The integer value to be checked for primality.
+ * @return `true` if the input value is a prime number, `false` otherwise.
+ *
+ * @note The function is marked as `noexcept`, indicating it does not throw exceptions,
+ *       and as `[[nodiscard]]`, which encourages the caller to use the return value.
+ *
+ * @example
+ * @code
+ * constexpr bool result = isprime(29); // result will be true
+ * @endcode
+ */
+constexpr [[nodiscard]] bool isprime(int val) noexcept
+{
+	if (val < 2)
+		return false;
+
+	if (val % 2 == 0)
+		return val == 2;
+
+	if (val % 3 == 0)
+		return val == 3;
+
+	if (val % 5 == 0)
+		return val == 5;
+
+	for (int k = 7; k * k <= val; k += 2)
+		if (val % k == 0)
+			return false;
+
+	return true;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+namespace detail {
+
+	/**
+	 * @brief Modular arithmetic in Montgomery form for an odd 64-bit modulus.
+	 */
+	class montgomery64 {
+	public:
+		constexpr explicit montgomery64(std::uint64_t n) noexcept : m_n{ n }
+		{
+			m_inv = n; //n * n == 1 (mod 8), every Newton step doubles the number of correct bits
+			for (int i = 0; i < 5; ++i)
+				m_inv *= 2 - n * m_inv;
+
+			m_one = (0 - n) % n; //2^64 mod n
+			m_r2 = m_one;
+			for (int i = 0; i < 64; ++i) //2^128 mod n
+				m_r2 = m_r2 >= n - m_r2 ? m_r2 - (n - m_r2) : m_r2 + m_r2;
+		}
+
+		[[nodiscard]] constexpr std::uint64_t to(std::uint64_t a) const noexcept
+		{
+			return mul(a % m_n, m_r2);
+		}
+
+		[[nodiscard]] constexpr std::uint64_t mul(std::uint64_t a, std::uint64_t b) const noexcept
+		{
+			std::uint64_t hi{};
+			const std::uint64_t lo = mul128(a, b, hi);
+			std::uint64_t mn_hi{};
+			mul128(lo * m_inv, m_n, mn_hi);
+			return hi >= mn_hi ? hi - mn_hi : hi - mn_hi + m_n;
+		}
+
+		[[nodiscard]] constexpr std::uint64_t pow(std::uint64_t base, std::uint64_t exp) const noexcept
+		{
+			std::uint64_t result = m_one;
+			for (; exp; exp >>= 1) {
+				if (exp & 1)
+					result = mul(result, base);
+				base = mul(base, base);
+			}
+			return result;
+		}
+
+		[[nodiscard]] constexpr std::uint64_t one() const noexcept { return m_one; }
+		[[nodiscard]] constexpr std::uint64_t minus_one() const noexcept { return m_n - m_one; }
+
+	private:
+		std::uint64_t m_n;
+		std::uint64_t m_inv{}; ///< n^-1 mod 2^64
+		std::uint64_t m_one{}; ///< 1 in Montgomery form
+		std::uint64_t m_r2{};  ///< 2^128 mod n
+	};
+}
+
+/**
+ * @brief Determines if a given 64-bit unsigned integer is a prime number.
+ *
+ * Small divisors are ruled out by trial division by the primes below 59. Larger values are
+ * tested with the deterministic Miller-Rabin test using the bases 2, 325, 9375, 28178, 450775,
+ * 9780504 and 1795265022, which gives the correct answer for every 64-bit value. The modular
+ * multiplications are done in Montgomery form, so the test needs no division at all.
+ *
+ * @param val The value to be checked for primality.
+ * @return `true` if the input value is a prime number, `false` otherwise.
+ *
+ * @example
+ * @code
+ * static_assert(isprime(std::uint64_t{ 18'446'744'073'709'551'557u })); // largest 64-bit prime
+ * @endcode
+ */
+[[nodiscard]] constexpr bool isprime(std::uint64_t val) noexcept
+{
+	constexpr std::uint64_t small_primes[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53 };
+	for (const auto p : small_primes)
+		if (val % p == 0)
+			return val == p;
+	if (val < 59 * 59)
+		return val >= 2;
+
+	const detail::montgomery64 mont{ val };
+	const int s = std::countr_zero(val - 1);
+	const std::uint64_t d = (val - 1) >> s;
+
+	for (const std::uint64_t a : { 2ull, 325ull, 9375ull, 28178ull, 450775ull, 9780504ull, 1795265022ull }) {
+		if (a % val == 0)
+			continue;
+		std::uint64_t x = mont.pow(mont.to(a), d);
+		if (x == mont.one() || x == mont.minus_one())
+			continue;
+		for (int r = 1; r < s && x != mont.minus_one(); ++r)
+			x = mont.mul(x, x);
+		if (x != mont.minus_one())
+			return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Determines if a value of any other integer type is a prime number.
+ *
+ * Negative values are never prime; all other values are tested by the `std::uint64_t` overload.
+ */
+template<std::integral T>
+[[nodiscard]] constexpr bool isprime(T val) noexcept
+{
+	if constexpr (std::is_signed_v<T>)
+		if (val < 0)
+			return false;
+	return isprime(static_cast<std::uint64_t>(val));
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+namespace detail {
+
+	inline constexpr std::size_t sieve_segment_bits = 32 * 1024 * 8; //one L1 data cache worth of odd numbers
+
+	[[nodiscard]] inline std::uint64_t isqrt(std::uint64_t n) noexcept
+	{
+		auto r = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+		while (r > 0 && r > n / r)
+			--r;
+		while ((r + 1) <= n / (r + 1))
+			++r;
+		return r;
+	}
+
+	/**
+	 * @brief Odd primes up to `limit` (at most 2^32), computed with a plain sieve.
+	 */
+	[[nodiscard]] inline std::vector<std::uint32_t> odd_base_primes(std::uint64_t limit)
+	{
+		std::vector<char> composite(limit / 2 + 1);
+		std::vector<std::uint32_t> primes;
+		for (std::uint64_t i = 3; i <= limit; i += 2) {
+			if (composite[i / 2])
+				continue;
+			primes.push_back(static_cast<std::uint32_t>(i));
+			for (std::uint64_t j = i * i; j <= limit; j += 2 * i)
+				composite[j / 2] = 1;
+		}
+		return primes;
+	}
+
+	/**
+	 * @brief Sieves the odd numbers `2 * idx + 1` for `idx` in [first_idx, first_idx + nbits).
+	 *
+	 * Bit `k` of `words` is set if `2 * (first_idx + k) + 1` is prime. The base primes must cover
+	 * the square root of the largest number of the segment.
+	 */
+	inline void sieve_segment(std::uint64_t* words, std::uint64_t first_idx, std::size_t nbits, const std::vector<std::uint32_t>& base)
+	{
+		const std::size_t nwords = (nbits + 63) / 64;
+		std::fill_n(words, nwords, ~std::uint64_t{ 0 });
+		if (nbits % 64)
+			words[nwords - 1] = (std::uint64_t{ 1 } << (nbits % 64)) - 1;
+		if (first_idx == 0)
+			words[0] &= ~std::uint64_t{ 1 }; //1 is not a prime
+
+		const std::uint64_t lo = 2 * first_idx + 1;
+		const std::uint64_t hi = 2 * (first_idx + nbits) - 1;
+		for (const std::uint64_t p : base) {
+			if (p * p > hi)
+				break;
+			std::uint64_t start = std::max(p * p, (lo + p - 1) / p * p);
+			if (start % 2 == 0)
+				start += p;
+			for (std::uint64_t k = (start - 1) / 2 - first_idx; k < nbits; k += p)
+				words[k / 64] &= ~(std::uint64_t{ 1 } << (k % 64));
+		}
+	}
+}
+
+/**
+ * @class prime_sieve
+ * @brief A segmented sieve of Eratosthenes answering primality queries by a table lookup.
+ *
+ * Only odd numbers are stored, one bit each, so the table takes `limit / 16` bytes. The table is
+ * computed in segments that fit into the L1 data cache; the segments can be distributed over
+ * several threads.
+ *
+ * @example
+ * @code
+ * prime_sieve sieve{ 100'000'000, 8 };
+ * std::vector<int> ivec;
+ * rfill(ivec, 1'000'000, Irand{ 0, 100'000'000 });
+ * std::erase_if(ivec, [&](int x) { return !sieve.is_prime(x); });
+ * @endcode
+ */
+
+class prime_sieve {
+public:
+	/**
+	 * @brief Sieves the numbers in [0, limit].
+	 *
+	 * @param limit The largest number the sieve answers queries for.
+	 * @param threads The number of threads used to compute the table.
+	 */
+	explicit prime_sieve(std::uint64_t limit, unsigned threads = 1) : m_limit{ limit }
+	{
+		const std::uint64_t nbits = (limit + 1) / 2; //odd numbers 1, 3, ..., up to limit
+		m_bits.resize((nbits + 63) / 64);
+		const auto base = detail::odd_base_primes(detail::isqrt(limit));
+
+		const std::size_t segments = (nbits + detail::sieve_segment_bits - 1) / detail::sieve_segment_bits;
+		detail::run_chunks(0, segments, threads, [&](std::size_t, std::size_t first, std::size_t last) {
+			for (std::size_t seg = first; seg != last; ++seg) {
+				const std::uint64_t first_idx = seg * detail::sieve_segment_bits;
+				const std::size_t cnt = static_cast<std::size_t>(std::min<std::uint64_t>(detail::sieve_segment_bits, nbits - first_idx));
+				detail::sieve_segment(m_bits.data() + first_idx / 64, first_idx, cnt, base);
+			}
+		});
+	}
+
+	/**
+	 * @brief Returns `true` if `val` is a prime number.
+	 *
+	 * @throws std::out_of_range If `val` is greater than the limit of the sieve.
+	 */
+	[[nodiscard]] bool is_prime(std::uint64_t val) const
+	{
+		if (val > m_limit)
+			throw std::out_of_range{ "prime_sieve : value is beyond the limit of the sieve!\n" };
+		if (val % 2 == 0)
+			return val == 2;
+		return m_bits[val / 128] >> (val / 2 % 64) & 1;
+	}
+
+	[[nodiscard]] bool operator()(std::uint64_t val) const
+	{
+		return is_prime(val);
+	}
+
+	[[nodiscard]] std::uint64_t limit() const noexcept
+	{
+		return m_limit;
+	}
+
+	/**
+	 * @brief Returns the number of primes in [0, limit].
+	 */
+	[[nodiscard]] std::size_t count() const noexcept
+	{
+		std::size_t cnt = m_limit >= 2;
+		for (const auto w : m_bits)
+			cnt += std::popcount(w);
+		return cnt;
+	}
+
+	/**
+	 * @brief Calls `f` with every prime in [0, limit] in ascending order.
+	 */
+	template<typename F>
+	void for_each(F f) const
+	{
+		if (m_limit >= 2)
+			f(std::uint64_t{ 2 });
+		for (std::size_t i = 0; i < m_bits.size(); ++i)
+			for (std::uint64_t w = m_bits[i]; w; w &= w - 1)
+				f(2 * (i * 64 + std::countr_zero(w)) + 1);
+	}
+
+private:
+	std::uint64_t m_limit;
+	std::vector<std::uint64_t> m_bits;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns all prime numbers in [0, n] in ascending order.
+ *
+ * @param n The upper bound (inclusive).
+ * @param threads The number of threads used by the sieve.
+ *
+ * @example
+ * @code
+ * auto primes = primes_up_to(100'000'000); // 5'761'455 primes
+ * @endcode
+ */
+[[nodiscard]] inline std::vector<std::uint64_t> primes_up_to(std::uint64_t n, unsigned threads = 1)
+{
+	const prime_sieve sieve{ n, threads };
+	std::vector<std::uint64_t> primes;
+	primes.reserve(sieve.count());
+	sieve.for_each([&](std::uint64_t p) { primes.push_back(p); });
+	return primes;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns the number of prime numbers in [0, n].
+ *
+ * The segments are sieved and counted one after the other into a buffer of L1 cache size,
+ * so apart from the base primes up to sqrt(n) no memory proportional to `n` is needed.
+ *
+ * @param n The upper bound (inclusive).
+ * @param threads The number of threads.
+ */
+[[nodiscard]] inline std::uint64_t prime_count(std::uint64_t n, unsigned threads = 1)
+{
+	const std::uint64_t nbits = (n + 1) / 2;
+	const auto base = detail::odd_base_primes(detail::isqrt(n));
+	const std::size_t segments = (nbits + detail::sieve_segment_bits - 1) / detail::sieve_segment_bits;
+
+	std::atomic<std::uint64_t> total{ n >= 2 };
+	detail::run_chunks(0, segments, threads, [&](std::size_t, std::size_t first, std::size_t last) {
+		std::vector<std::uint64_t> words(detail::sieve_segment_bits / 64);
+		std::uint64_t cnt = 0;
+		for (std::size_t seg = first; seg != last; ++seg) {
+			const std::uint64_t first_idx = seg * detail::sieve_segment_bits;
+			const std::size_t nb = static_cast<std::size_t>(std::min<std::uint64_t>(detail::sieve_segment_bits, nbits - first_idx));
+			detail::sieve_segment(words.data(), first_idx, nb, base);
+			for (std::size_t i = 0; i < (nb + 63) / 64; ++i)
+				cnt += std::popcount(words[i]);
+		}
+		total += cnt;
+	});
+	return total;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns a compile-time table of all prime numbers in [0, N].
+ *
+ * @tparam N The upper bound (inclusive). Intended for small bounds; the table is computed
+ *         by the compiler.
+ *
+ * @example
+ * @code
+ * constexpr auto small_primes = prime_table<100>(); // std::array<int, 25>
+ * static_assert(small_primes[24] == 97);
+ * @endcode
+ */
+template<int N>
+[[nodiscard]] constexpr auto prime_table()
+{
+	constexpr auto sieve = [] {
+		std::array<bool, N + 1> composite{};
+		for (int i = 2; i * i <= N; ++i)
+			if (!composite[i])
+				for (int j = i * i; j <= N; j += i)
+					composite[j] = true;
+		return composite;
+	}();
+
+	constexpr std::size_t cnt = [&] {
+		std::size_t c = 0;
+		for (int i = 2; i <= N; ++i)
+			c += !sieve[i];
+		return c;
+	}();
+
+	std::array<int, cnt> primes{};
+	for (std::size_t i = 0, k = 2; i < cnt; ++k)
+		if (!sieve[k])
+			primes[i++] = static_cast<int>(k);
+	return primes;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef __int128 int128;
+	__extension__ typedef unsigned __int128 uint128;
+#endif
+
+	/**
+	 * @brief Number of decimal digits of an unsigned value with `Bits` value bits.
+	 *
+	 * The bit length of the value gives an estimate of the number of digits that is correct
+	 * or one too large (`bits * 1233 / 4096` approximates `bits * log10(2)`); a single comparison
+	 * with a power of ten resolves it.
+	 */
+	template<int Bits, typename U>
+	[[nodiscard]] constexpr int ndigit_unsigned(U val, int leading_zeros) noexcept
+	{
+		constexpr auto pow10 = [] {
+			std::array<U, Bits * 1233 / 4096 + 1> table{};
+			U p = 1;
+			for (auto& x : table) {
+				x = p;
+				p *= 10;
+			}
+			return table;
+		}();
+
+		const int t = (Bits - leading_zeros) * 1233 >> 12;
+		return t + 1 - (val < pow10[t]);
+	}
+}
+
+/**
+ * @brief Calculates the number of digits in an integer.
+ *
+ * This `constexpr` function determines the number of digits in the given integer `val`.
+ * It handles both positive and negative integers, as well as zero. For a value of zero,
+ * the function returns 1, since zero is considered to have one digit.
+ *
+ * The function works for every integer type. Instead of a division loop it uses the number
+ * of leading zero bits (`std::countl_zero`) and one lookup in a table of powers of ten.
+ * The magnitude of a negative value is computed in the unsigned type, so the minimum value
+ * of a signed type is handled correctly as well.
+ *
+ * @param val The integer whose digits are to be counted.
+ * @return An `int` representing the number of digits in the input integer.
+ *
+ * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+ *
+ * @example
+ * @code
+ * int num_digits = ndigit(12345); // Returns 5
+ * int num_digits_negative = ndigit(-987); // Returns 3
+ * int num_digits_zero = ndigit(0); // Returns 1
+ * int num_digits_max = ndigit(UINT64_MAX); // Returns 20
+ * std::cout << "Digits: " << num_digits << std::endl;
+ * @endcode
+ */
+template<std::integral T>
+	requires (!std::is_same_v<T, bool>)
+[[nodiscard]] constexpr int ndigit(T val) noexcept
+{
+	using U = std::make_unsigned_t<T>;
+	const U mag = val < 0 ? static_cast<U>(U{ 0 } - static_cast<U>(val)) : static_cast<U>(val);
+	const U nonzero = mag | 1;
+	return detail::ndigit_unsigned<std::numeric_limits<U>::digits>(nonzero, std::countl_zero(nonzero));
+}
+
+#if defined(__SIZEOF_INT128__)
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Calculates the number of digits of an unsigned 128-bit integer.
+ */
+[[nodiscard]] constexpr int ndigit(detail::uint128 val) noexcept
+{
+	val |= 1;
+	const auto hi = static_cast<std::uint64_t>(val >> 64);
+	const int leading_zeros = hi ? std::countl_zero(hi) : 64 + std::countl_zero(static_cast<std::uint64_t>(val));
+	return detail::ndigit_unsigned<128>(val, leading_zeros);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Calculates the number of digits of a signed 128-bit integer.
+ */
+[[nodiscard]] constexpr int ndigit(detail::int128 val) noexcept
+{
+	const auto uval = static_cast<detail::uint128>(val);
+	return ndigit(val < 0 ? 0 - uval : uval);
+}
+#endif
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief An ostream manipulator that inserts a line of dash characters into the stream.
+ *
+ * The `dash_line` manipulator outputs a line of dash characters, followed by newline characters,
+ * to the given output stream. It is commonly used to create a visual separation or underline
+ * in the output for better readability.
+ *
+ * @param os The output stream to which the line of dash characters is inserted.
+ * @return A reference to the modified output stream.
+ *
+ * @example
+ * @code
+ * std::cout << "Header" << dash_line << "Content" << std::endl;
+ * @endcode
+ * This will produce:
+ * @code
+ * Header
+ * -----------------------------------------------------------------------------
+ * Content
+ * @endcode
+ */
+inline std::ostream& dash_line(std::ostream& os)
+{
+	return os << "\n-----------------------------------------------------------------------------\n";
+}
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   file operations   */
+
+namespace detail {
+
+	/**
+	 * @brief Reads the rest of a stream into a string allocated once with the remaining size.
+	 */
+	[[nodiscard]] inline std::string read_stream(std::istream& is)
+	{
+		std::string str;
+		const auto pos = is.tellg();
+		if (pos != std::istream::pos_type(-1) && is.seekg(0, std::ios::end)) {
+			const auto size = static_cast<std::size_t>(is.tellg() - pos);
+			is.seekg(pos);
+			str.resize(size);
+			is.read(str.data(), static_cast<std::streamsize>(size));
+			str.resize(static_cast<std::size_t>(is.gcount())); //text mode may shrink the content
+			if (!is.eof())
+				return str;
+			is.clear();
+		}
+		std::ostringstream oss; //not seekable, or grown while reading
+		oss << is.rdbuf();
+		return str + std::move(oss).str();
+	}
+}
+
+inline [[nodiscard]] std::ifstream open_text_file(const std::string& filename)
+{
+	std::ifstream ifs{ filename };
+	if (!ifs) {
+		throw std::runtime_error{ filename + " : cannot be opened!\n" };
+	}
+
+	return ifs;
+}
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Creates a text file and returns an std::ofstream object for it.
+ *
+ * This function attempts to create a text file with the specified name and
+ * returns an `std::ofstream` object that can be used to write to the file.
+ * If the file cannot be created, a `std::runtime_error` is thrown.
+ *
+ * @param filename The name of the file to be created.
+ *
+ * @return An `std::ofstream` object that controls the newly created text file.
+ *
+ * @throws std::runtime_error If the file cannot be created.
+ *
+ * @note The file is opened in text mode by default. No special mode flags
+ * are set.
+ *
+ * @warning Ensure that the file name is valid and that you have appropriate
+ * permissions to create files in the specified directory.
+ */
+inline [[nodiscard]] std::ofstream create_text_file(const std::string& filename)
+{
+	std::ofstream ofs{ filename };
+
+	if (!ofs) {
+		throw std::runtime_error{ filename + ": cannot be created!\n" };
+	}
+
+	return ofs;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+inline [[nodiscard]] std::ifstream open_binary_file(const std::string& filename)
+{
+	std::ifstream ifs{ filename, std::ios::binary };
+	if (!ifs) {
+		throw std::runtime_error{ filename + " : cannot be opened!\n" };
+	}
+
+	return ifs;
+}
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Creates a binary file and returns an std::ofstream object for it.
+ *
+ * This function attempts to create a binary file with the specified name and
+ * returns an `std::ofstream` object that can be used to write to the file.
+ * If the file cannot be created, a `std::runtime_error` is thrown.
+ *
+ * @param filename The name of the file to be created.
+ *
+ * @return An `std::ofstream` object that controls the newly created binary file.
+ *
+ * @throws std::runtime_error If the file cannot be created.
+ *
+ * @note The file is opened in binary mode (`std::ios::binary`), so no
+ * conversions or translations of the data will occur.
+ *
+ * @warning Ensure that the file name is valid and that you have appropriate
+ * permissions to create files in the specified directory.
+ */
+inline [[nodiscard]] std::ofstream create_binary_file(const std::string& filename)
+{
+	std::ofstream ofs{ filename, std::ios::binary };
+
+	if (!ofs) {
+		throw std::runtime_error{ filename + " : cannot be created!\n" };
+	}
+
+	return ofs;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class async_writer
+ * @brief A file sink that writes on a background thread while the caller keeps producing data.
+ *
+ * The writer owns two buffers. The caller fills one of them; when it is full the buffers are
+ * swapped and a background thread writes the full one to the file with a single large write,
+ * so data generation and disk I/O overlap. The caller only waits if it fills a buffer before
+ * the previous one has been written.
+ *
+ * Objects are created by `create_async_text_file` and `create_async_binary_file`. They are
+ * movable but not copyable. `close()` writes the remaining data and throws a `std::runtime_error`
+ * if any write failed; a failure is also reported by the next buffer swap. The destructor closes
+ * the file without reporting errors.
+ *
+ * @example
+ * @code
+ * auto out = create_async_text_file("names.txt");
+ * for (int i = 0; i < 10'000'000; ++i)
+ *     out << random_name_sv() << ' ' << Irand{ 18, 90 }() << '\n';
+ * out.close();
+ * @endcode
+ */
+
+class async_writer {
+public:
+	static constexpr std::size_t default_buffer_size = std::size_t{ 1 } << 20;
+
+	async_writer() = default;
+	async_writer(async_writer&&) noexcept = default;
+
+	async_writer& operator=(async_writer&& other) noexcept
+	{
+		if (this != &other) {
+			close_noexcept();
+			m_impl = std::move(other.m_impl);
+		}
+		return *this;
+	}
+
+	~async_writer()
+	{
+		close_noexcept();
+	}
+
+	/**
+	 * @brief Returns `true` if the file is open.
+	 */
+	[[nodiscard]] bool is_open() const noexcept
+	{
+		return m_impl != nullptr;
+	}
+
+	/**
+	 * @brief Appends `n` bytes starting at `p`.
+	 */
+	async_writer& write(const void* p, std::size_t n)
+	{
+		auto src = static_cast<const char*>(p);
+		impl& im = get();
+		while (n) {
+			const std::size_t cnt = std::min(n, im.capacity - im.front.size());
+			im.front.insert(im.front.end(), src, src + cnt);
+			src += cnt;
+			n -= cnt;
+			if (im.front.size() == im.capacity)
+				im.submit();
+		}
+		return *this;
+	}
+
+	async_writer& write(std::string_view sv)
+	{
+		return write(sv.data(), sv.size());
+	}
+
+	/**
+	 * @brief Appends the object representation of the elements of a contiguous range of trivially copyable objects.
+	 */
+	template<std::ranges::contiguous_range R>
+		requires std::is_trivially_copyable_v<std::ranges::range_value_t<R>> && (!std::is_convertible_v<const R&, std::string_view>)
+	async_writer& write(const R& r)
+	{
+		return write(std::ranges::data(r), std::ranges::size(r) * sizeof(std::ranges::range_value_t<R>));
+	}
+
+	async_writer& put(char c)
+	{
+		impl& im = get();
+		im.front.push_back(c);
+		if (im.front.size() == im.capacity)
+			im.submit();
+		return *this;
+	}
+
+	async_writer& operator<<(char c)
+	{
+		return put(c);
+	}
+
+	async_writer& operator<<(std::string_view sv)
+	{
+		return write(sv);
+	}
+
+	async_writer& operator<<(const char* p)
+	{
+		return write(std::string_view{ p });
+	}
+
+	async_writer& operator<<(const std::string& s)
+	{
+		return write(std::string_view{ s });
+	}
+
+	/**
+	 * @brief Appends the shortest decimal representation (`std::to_chars`) of an arithmetic value.
+	 */
+	template<typename T>
+		requires std::is_arithmetic_v<T> && (!std::is_same_v<T, char>)
+	async_writer& operator<<(T val)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+			return put(val ? '1' : '0');
+		else {
+			char buf[64];
+			const auto res = std::to_chars(buf, buf + sizeof buf, val);
+			return write(buf, static_cast<std::size_t>(res.ptr - buf));
+		}
+	}
+
+	/**
+	 * @brief Hands the buffered data to the background thread without waiting for it to be written.
+	 */
+	void flush()
+	{
+		get().submit();
+	}
+
+	/**
+	 * @brief Writes the remaining data, stops the background thread and closes the file.
+	 *
+	 * @throws std::runtime_error If the file could not be written completely.
+	 */
+	void close()
+	{
+		if (!m_impl)
+			return;
+		auto im = std::move(m_impl);
+		if (!im->finish())
+			throw std::runtime_error{ im->filename + " : cannot be written!\n" };
+	}
+
+private:
+	struct impl {
+		std::string filename;
+		std::FILE* fp = nullptr;
+		std::size_t capacity;
+		std::vector<char> front;
+		std::vector<char> back;
+		std::mutex mtx;
+		std::condition_variable cv;
+		bool busy = false; //the back buffer is being written
+		bool stop = false;
+		bool failed = false;
+		std::thread worker;
+
+		impl(std::string name, std::FILE* f, std::size_t buffer_size) : filename{ std::move(name) }, fp{ f }, capacity{ buffer_size }
+		{
+			front.reserve(capacity);
+			back.reserve(capacity);
+			worker = std::thread{ [this] { run(); } };
+		}
+
+		~impl()
+		{
+			if (worker.joinable())
+				(void)finish();
+		}
+
+		void run()
+		{
+			std::unique_lock lock{ mtx };
+			for (;;) {
+				cv.wait(lock, [this] { return busy || stop; });
+				if (!busy)
+					return;
+				lock.unlock();
+				const bool ok = std::fwrite(back.data(), 1, back.size(), fp) == back.size();
+				back.clear();
+				lock.lock();
+				failed = failed || !ok;
+				busy = false;
+				cv.notify_all();
+			}
+		}
+
+		void submit()
+		{
+			std::unique_lock lock{ mtx };
+			cv.wait(lock, [this] { return !busy; });
+			if (failed)
+				throw std::runtime_error{ filename + " : cannot be written!\n" };
+			if (front.empty())
+				return;
+			front.swap(back);
+			busy = true;
+			cv.notify_all();
+		}
+
+		[[nodiscard]] bool finish() noexcept
+		{
+			{
+				std::unique_lock lock{ mtx };
+				cv.wait(lock, [this] { return !busy; });
+				if (!front.empty() && !failed) {
+					front.swap(back);
+					busy = true;
+					cv.notify_all();
+					cv.wait(lock, [this] { return !busy; });
+				}
+				stop = true;
+				cv.notify_all();
+			}
+			worker.join();
+			const bool closed = std::fclose(fp) == 0;
+			return closed && !failed;
+		}
+	};
+
+	friend async_writer create_async_text_file(const std::string& filename, std::size_t buffer_size);
+	friend async_writer create_async_binary_file(const std::string& filename, std::size_t buffer_size);
+
+	static async_writer open(const std::string& filename, const char* mode, std::size_t buffer_size)
+	{
+		std::FILE* fp = std::fopen(filename.c_str(), mode);
+		if (!fp)
+			throw std::runtime_error{ filename + " : cannot be created!\n" };
+		std::setvbuf(fp, nullptr, _IONBF, 0); //the buffers of the writer are large enough
+		async_writer w;
+		try {
+			w.m_impl = std::make_unique<impl>(filename, fp, std::max<std::size_t>(buffer_size, 4096));
+		}
+		catch (...) {
+			std::fclose(fp);
+			throw;
+		}
+		return w;
+	}
+
+	impl& get()
+	{
+		if (!m_impl)
+			throw std::logic_error{ "async_writer : the file is not open!\n" };
+		return *m_impl;
+	}
+
+	void close_noexcept() noexcept
+	{
+		if (m_impl) {
+			(void)m_impl->finish();
+			m_impl.reset();
+		}
+	}
+
+	std::unique_ptr<impl> m_impl;
+};
+
+/**
+ * @brief Creates a text file and returns an `async_writer` for it.
+ *
+ * @param filename The name of the file to be created.
+ * @param buffer_size The size of each of the two buffers. The default is 1 MiB.
+ *
+ * @throws std::runtime_error If the file cannot be created.
+ */
+[[nodiscard]] inline async_writer create_async_text_file(const std::string& filename, std::size_t buffer_size = async_writer::default_buffer_size)
+{
+	return async_writer::open(filename, "w", buffer_size);
+}
+
+/**
+ * @brief Creates a binary file and returns an `async_writer` for it.
+ *
+ * @param filename The name of the file to be created.
+ * @param buffer_size The size of each of the two buffers. The default is 1 MiB.
+ *
+ * @throws std::runtime_error If the file cannot be created.
+ */
+[[nodiscard]] inline async_writer create_async_binary_file(const std::string& filename, std::size_t buffer_size = async_writer::default_buffer_size)
+{
+	return async_writer::open(filename, "wb", buffer_size);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Reads the entire content of a text file into a std::string.
+ *
+ * This function opens the specified text file using the `open_text_file` function,
+ * reads its content, and returns it as a `std::string`.
+ *
+ * @param filename The name of the file to be read.
+ *
+ * @return A `std::string` containing the content of the file.
+ *
+ * @throws std::ifstream::failure If the file could not be opened or read.
+ *
+ * @note The file is opened in text mode. Ensure that the file exists and is accessible.
+ * The string is allocated once with the size of the file and filled by a single read.
+ *
+ * @warning This function does not handle file encoding issues. For very large files
+ * consider `map_text_file`, which does not copy the content at all.
+ */
+inline [[nodiscard]] std::string get_str_from_file(const std::string& filename)
+{
+	std::ifstream ifs{ open_text_file(filename) };
+	return detail::read_stream(ifs);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief A read-only, memory-mapped view of a whole file.
+ *
+ * The file is mapped with `mmap` (POSIX) or `CreateFileMapping`/`MapViewOfFile` (Windows) and
+ * unmapped when the object is destroyed, so the content is available without being copied.
+ * If the file cannot be mapped (e.g. a pipe or a special file), its content is read into a
+ * string owned by the object instead; `is_mapped()` tells which one happened.
+ *
+ * @note A mapping exposes the bytes of the file as they are; no end-of-line conversion is done.
+ *
+ * @example
+ * @code
+ * mapped_file mf{ "corpus.txt" };
+ * auto n = std::count(mf.view().begin(), mf.view().end(), '\n');
+ * @endcode
+ */
+
+class mapped_file {
+public:
+	mapped_file() = default;
+
+	/**
+	 * @brief Maps the file `filename`.
+	 *
+	 * @throws std::runtime_error If the file cannot be opened.
+	 */
+	explicit mapped_file(const std::string& filename)
+	{
+#if defined(_WIN32)
+		HANDLE file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error{ filename + " : cannot be opened!\n" };
+
+		LARGE_INTEGER fsize{};
+		if (::GetFileSizeEx(file, &fsize) && fsize.QuadPart > 0) {
+			if (HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+				m_data = static_cast<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				::CloseHandle(mapping);
+				m_size = static_cast<std::size_t>(fsize.QuadPart);
+			}
+		}
+		::CloseHandle(file);
+#else
+		const int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			throw std::runtime_error{ filename + " : cannot be opened!\n" };
+
+		struct stat st {};
+		if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+			void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p != MAP_FAILED) {
+				m_data = static_cast<const char*>(p);
+				m_size = static_cast<std::size_t>(st.st_size);
+			}
+		}
+		::close(fd);
+#endif
+		if (!m_data) { //empty or not mappable
+			m_size = 0;
+			std::ifstream ifs{ open_binary_file(filename) };
+			m_fallback = detail::read_stream(ifs);
+		}
+	}
+
+	mapped_file(mapped_file&& other) noexcept
+		: m_data{ std::exchange(other.m_data, nullptr) }, m_size{ std::exchange(other.m_size, 0) }, m_fallback{ std::move(other.m_fallback) } {}
+
+	mapped_file& operator=(mapped_file&& other) noexcept
+	{
+		if (this != &other) {
+			unmap();
+			m_data = std::exchange(other.m_data, nullptr);
+			m_size = std::exchange(other.m_size, 0);
+			m_fallback = std::move(other.m_fallback);
+		}
+		return *this;
+	}
+
+	~mapped_file()
+	{
+		unmap();
+	}
+
+	[[nodiscard]] const char* data() const noexcept
+	{
+		return m_data ? m_data : m_fallback.data();
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return m_data ? m_size : m_fallback.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	/**
+	 * @brief Returns `true` if the content is memory-mapped, `false` if it was read into memory.
+	 */
+	[[nodiscard]] bool is_mapped() const noexcept
+	{
+		return m_data != nullptr;
+	}
+
+	[[nodiscard]] std::string_view view() const noexcept
+	{
+		return { data(), size() };
+	}
+
+	[[nodiscard]] std::span<const std::byte> bytes() const noexcept
+	{
+		return { reinterpret_cast<const std::byte*>(data()), size() };
+	}
+
+private:
+	void unmap() noexcept
+	{
+		if (m_data) {
+#if defined(_WIN32)
+			::UnmapViewOfFile(m_data);
+#else
+			::munmap(const_cast<char*>(m_data), m_size);
+#endif
+		}
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	const char* m_data = nullptr;
+	std::size_t m_size = 0;
+	std::string m_fallback;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Maps a text file into memory.
+ *
+ * @param filename The name of the file to be mapped.
+ * @return A `mapped_file` whose `view()` is the content of the file.
+ *
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+[[nodiscard]] inline mapped_file map_text_file(const std::string& filename)
+{
+	return mapped_file{ filename };
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Maps a binary file into memory.
+ *
+ * @param filename The name of the file to be mapped.
+ * @return A `mapped_file` whose `bytes()` is the content of the file.
+ *
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+[[nodiscard]] inline mapped_file map_binary_file(const std::string& filename)
+{
+	return mapped_file{ filename };
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief An input range over the lines (or `delim` separated records) of a file.
+ *
+ * The file is read in large blocks into a reusable buffer and every line is handed out as a
+ * `std::string_view` into that buffer, so no per-line allocation takes place and the memory use
+ * does not depend on the size of the file. The buffer only grows if a single line is longer
+ * than it. When the delimiter is `'\n'`, a `'\r'` in front of it (CRLF line ending) is removed.
+ *
+ * @note A `std::string_view` obtained from the range is valid only until the iterator is incremented.
+ *
+ * @example
+ * @code
+ * std::size_t total_len = 0;
+ * for (std::string_view line : lines("server.log"))
+ *     total_len += line.size();
+ * @endcode
+ */
+
+class line_reader {
+public:
+	class iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const std::string_view*;
+		using reference = const std::string_view&;
+
+		iterator() = default;
+
+		reference operator*() const noexcept { return m_line; }
+		pointer operator->() const noexcept { return &m_line; }
+
+		iterator& operator++()
+		{
+			if (!m_reader->next(m_line))
+				m_reader = nullptr;
+			return *this;
+		}
+
+		void operator++(int)
+		{
+			++*this;
+		}
+
+		friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+		{
+			return it.m_reader == nullptr;
+		}
+
+	private:
+		friend class line_reader;
+
+		explicit iterator(line_reader* reader) : m_reader{ reader }
+		{
+			++*this;
+		}
+
+		line_reader* m_reader = nullptr;
+		std::string_view m_line;
+	};
+
+	/**
+	 * @brief Opens the file `filename` for reading its records.
+	 *
+	 * @param filename The name of the file.
+	 * @param delim The character terminating the records.
+	 * @param buffer_size The initial size of the read buffer.
+	 *
+	 * @throws std::runtime_error If the file cannot be opened.
+	 */
+	explicit line_reader(const std::string& filename, char delim = '\n', std::size_t buffer_size = 1 << 20)
+		: m_ifs{ open_binary_file(filename) }, m_buf(std::max<std::size_t>(buffer_size, 64)), m_delim{ delim } {}
+
+	line_reader(const line_reader&) = delete;
+	line_reader& operator=(const line_reader&) = delete;
+	line_reader(line_reader&&) = default;
+	line_reader& operator=(line_reader&&) = default;
+
+	[[nodiscard]] iterator begin()
+	{
+		return iterator{ this };
+	}
+
+	[[nodiscard]] std::default_sentinel_t end() const noexcept
+	{
+		return {};
+	}
+
+	/**
+	 * @brief Reads the next record into `line`.
+	 *
+	 * @return `false` if there are no more records.
+	 */
+	bool next(std::string_view& line)
+	{
+		for (;;) {
+			const char* first = m_buf.data() + m_begin;
+			if (const auto p = static_cast<const char*>(std::memchr(first, m_delim, m_end - m_begin))) {
+				m_begin = static_cast<std::size_t>(p - m_buf.data()) + 1;
+				line = trim_cr({ first, static_cast<std::size_t>(p - first) });
+				return true;
+			}
+
+			if (m_eof) {
+				if (m_begin == m_end)
+					return false;
+				line = trim_cr({ first, m_end - m_begin });
+				m_begin = m_end;
+				return true;
+			}
+
+			refill();
+		}
+	}
+
+private:
+	void refill()
+	{
+		if (m_begin) {
+			std::memmove(m_buf.data(), m_buf.data() + m_begin, m_end - m_begin);
+			m_end -= m_begin;
+			m_begin = 0;
+		}
+		if (m_end == m_buf.size()) //a single record longer than the buffer
+			m_buf.resize(m_buf.size() * 2);
+
+		const auto cnt = m_ifs.rdbuf()->sgetn(m_buf.data() + m_end, static_cast<std::streamsize>(m_buf.size() - m_end));
+		if (cnt <= 0)
+			m_eof = true;
+		else
+			m_end += static_cast<std::size_t>(cnt);
+	}
+
+	[[nodiscard]] std::string_view trim_cr(std::string_view sv) const noexcept
+	{
+		if (m_delim == '\n' && !sv.empty() && sv.back() == '\r')
+			sv.remove_suffix(1);
+		return sv;
+	}
+
+	std::ifstream m_ifs;
+	std::vector<char> m_buf;
+	std::size_t m_begin = 0;
+	std::size_t m_end = 0;
+	char m_delim;
+	bool m_eof = false;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns a range over the lines (or `delim` separated records) of a text file.
+ *
+ * @param filename The name of the file.
+ * @param delim The character terminating the records, e.g. `'\n'` for lines or `'\0'` for
+ *        null-terminated records. For CSV/TSV data every record is one line.
+ * @return A `line_reader` to be used in a range-based for loop.
+ *
+ * @throws std::runtime_error If the file cannot be opened.
+ */
+[[nodiscard]] inline line_reader lines(const std::string& filename, char delim = '\n')
+{
+	return line_reader{ filename, delim };
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   binary fixture files   */
+
+/**
+ * @brief Element type codes of the binary fixture format.
+ */
+enum class fixture_type : std::uint16_t {
+	raw,    ///< any other trivially copyable type, identified by its size only
+	int8, uint8, int16, uint16, int32, uint32, int64, uint64,
+	float32, float64,
+	string, ///< string column: (count + 1) 64-bit offsets followed by the characters
+};
+
+/**
+ * @brief The header at the beginning of every binary fixture file.
+ *
+ * All fields are stored in the byte order of the machine that wrote the file. The payload
+ * follows the header directly; since the header is 40 bytes long, the payload is suitably
+ * aligned for every fundamental type when the file is memory-mapped.
+ */
+struct fixture_header {
+	static constexpr char file_magic[4] = { 'N', 'U', 'T', 'F' };
+	static constexpr std::uint16_t current_version = 1;
+
+	char magic[4] = { 'N', 'U', 'T', 'F' };
+	std::uint16_t version = current_version;
+	fixture_type type = fixture_type::raw;
+	std::uint32_t element_size = 0;
+	std::uint32_t reserved = 0;
+	std::uint64_t count = 0;         ///< number of elements
+	std::uint64_t seed = 0;          ///< seed the data was generated with, as given by the writer
+	std::uint64_t payload_bytes = 0; ///< size of the data following the header
+};
+
+static_assert(sizeof(fixture_header) == 40 && std::is_trivially_copyable_v<fixture_header>);
+
+namespace detail {
+
+	template<typename T>
+	[[nodiscard]] constexpr fixture_type fixture_type_of() noexcept
+	{
+		if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+			constexpr bool s = std::is_signed_v<T>;
+			switch (sizeof(T)) {
+			case 1: return s ? fixture_type::int8 : fixture_type::uint8;
+			case 2: return s ? fixture_type::int16 : fixture_type::uint16;
+			case 4: return s ? fixture_type::int32 : fixture_type::uint32;
+			case 8: return s ? fixture_type::int64 : fixture_type::uint64;
+			}
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			if (sizeof(T) == 4)
+				return fixture_type::float32;
+			if (sizeof(T) == 8)
+				return fixture_type::float64;
+		}
+		return fixture_type::raw;
+	}
+
+	inline void write_bytes(std::ofstream& ofs, const void* p, std::size_t n, const std::string& filename)
+	{
+		if (!ofs.write(static_cast<const char*>(p), static_cast<std::streamsize>(n)))
+			throw std::runtime_error{ filename + " : cannot be written!\n" };
+	}
+
+	inline void read_bytes(std::ifstream& ifs, void* p, std::size_t n, const std::string& filename)
+	{
+		if (!ifs.read(static_cast<char*>(p), static_cast<std::streamsize>(n)))
+			throw std::runtime_error{ filename + " : unexpected end of fixture file!\n" };
+	}
+
+	inline void check_fixture_header(const fixture_header& hdr, fixture_type type, std::size_t element_size, const std::string& filename)
+	{
+		if (std::memcmp(hdr.magic, fixture_header::file_magic, sizeof hdr.magic) != 0)
+			throw std::runtime_error{ filename + " : not a fixture file!\n" };
+		if (hdr.version != fixture_header::current_version)
+			throw std::runtime_error{ filename + " : unsupported fixture version!\n" };
+		if (hdr.type != type || hdr.element_size != element_size)
+			throw std::runtime_error{ filename + " : fixture element type mismatch!\n" };
+	}
+
+	template<typename C>
+	concept trivial_contiguous = std::ranges::contiguous_range<C> && std::ranges::sized_range<C>
+		&& std::is_trivially_copyable_v<std::ranges::range_value_t<C>>
+		&& !std::is_convertible_v<std::ranges::range_value_t<C>, std::string_view>; //views and pointers are saved as strings
+
+	template<typename C>
+	concept string_range = std::ranges::sized_range<C>
+		&& std::is_convertible_v<std::ranges::range_reference_t<const C&>, std::string_view>;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Saves the elements of a contiguous container of trivially copyable type to a fixture file.
+ *
+ * The file consists of a `fixture_header` followed by the raw bytes of the elements, written
+ * with a single `write`. Cached fixtures can then be loaded with `load_fixture` (one `read`)
+ * or `map_fixture` (no copy at all) instead of being generated again.
+ *
+ * @param filename The name of the file to be created.
+ * @param c The container (`std::vector`, `std::array`, `std::span`, ...).
+ * @param seed The seed stored in the header, by default the current master seed.
+ *
+ * @throws std::runtime_error If the file cannot be created or written.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * rfill(ivec, 250'000'000, Irand{ 0, 1'000'000 });
+ * save_fixture("ivec.fix", ivec);
+ * @endcode
+ */
+template<detail::trivial_contiguous C>
+void save_fixture(const std::string& filename, const C& c, std::uint64_t seed = master_seed())
+{
+	using T = std::ranges::range_value_t<C>;
+
+	fixture_header hdr;
+	hdr.type = detail::fixture_type_of<T>();
+	hdr.element_size = sizeof(T);
+	hdr.count = std::ranges::size(c);
+	hdr.seed = seed;
+	hdr.payload_bytes = hdr.count * sizeof(T);
+
+	auto ofs = create_binary_file(filename);
+	detail::write_bytes(ofs, &hdr, sizeof hdr, filename);
+	detail::write_bytes(ofs, std::ranges::data(c), hdr.payload_bytes, filename);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Saves a string column (e.g. `std::vector<std::string>` or `std::vector<std::string_view>`) to a fixture file.
+ *
+ * The payload consists of `count + 1` 64-bit offsets followed by all characters.
+ */
+template<detail::string_range C>
+	requires (!detail::trivial_contiguous<C>)
+void save_fixture(const std::string& filename, const C& c, std::uint64_t seed = master_seed())
+{
+	std::vector<std::uint64_t> offsets;
+	offsets.reserve(std::ranges::size(c) + 1);
+	offsets.push_back(0);
+	for (std::string_view sv : c)
+		offsets.push_back(offsets.back() + sv.size());
+
+	std::string chars;
+	chars.reserve(offsets.back());
+	for (std::string_view sv : c)
+		chars += sv;
+
+	fixture_header hdr;
+	hdr.type = fixture_type::string;
+	hdr.element_size = 1;
+	hdr.count = std::ranges::size(c);
+	hdr.seed = seed;
+	hdr.payload_bytes = offsets.size() * sizeof(std::uint64_t) + chars.size();
+
+	auto ofs = create_binary_file(filename);
+	detail::write_bytes(ofs, &hdr, sizeof hdr, filename);
+	detail::write_bytes(ofs, offsets.data(), offsets.size() * sizeof(std::uint64_t), filename);
+	detail::write_bytes(ofs, chars.data(), chars.size(), filename);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Loads a fixture file saved by `save_fixture` into a vector.
+ *
+ * The vector is resized once and filled by a single `read`.
+ *
+ * @param filename The name of the fixture file.
+ * @param vec The vector whose contents are replaced.
+ * @return The header of the file (e.g. to get the seed the data was generated with).
+ *
+ * @throws std::runtime_error If the file cannot be opened, is not a fixture file or holds
+ *         elements of another type.
+ */
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+fixture_header load_fixture(const std::string& filename, std::vector<T>& vec)
+{
+	auto ifs = open_binary_file(filename);
+	fixture_header hdr;
+	detail::read_bytes(ifs, &hdr, sizeof hdr, filename);
+	detail::check_fixture_header(hdr, detail::fixture_type_of<T>(), sizeof(T), filename);
+
+	vec.resize(hdr.count);
+	detail::read_bytes(ifs, vec.data(), hdr.count * sizeof(T), filename);
+	return hdr;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Loads a string column saved by `save_fixture` into a vector of strings.
+ */
+inline fixture_header load_fixture(const std::string& filename, std::vector<std::string>& vec)
+{
+	auto ifs = open_binary_file(filename);
+	fixture_header hdr;
+	detail::read_bytes(ifs, &hdr, sizeof hdr, filename);
+	detail::check_fixture_header(hdr, fixture_type::string, 1, filename);
+
+	std::vector<std::uint64_t> offsets(hdr.count + 1);
+	detail::read_bytes(ifs, offsets.data(), offsets.size() * sizeof(std::uint64_t), filename);
+	std::string chars(offsets.back(), '\0');
+	detail::read_bytes(ifs, chars.data(), chars.size(), filename);
+
+	vec.clear();
+	vec.reserve(hdr.count);
+	for (std::size_t i = 0; i < hdr.count; ++i)
+		vec.emplace_back(chars, offsets[i], offsets[i + 1] - offsets[i]);
+	return hdr;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief A memory-mapped, read-only fixture file.
+ *
+ * The elements are used directly from the mapping, so opening even a very large fixture takes
+ * only the time needed to map it.
+ *
+ * @tparam T The element type the file was saved with.
+ *
+ * @example
+ * @code
+ * auto fix = map_fixture<int>("ivec.fix");
+ * std::span<const int> data = fix.data();
+ * std::set<int> s(data.begin(), data.end());
+ * @endcode
+ */
+template<typename T>
+	requires std::is_trivially_copyable_v<T>
+class mapped_fixture {
+public:
+	/**
+	 * @throws std::runtime_error If the file cannot be opened, is not a fixture file or holds
+	 *         elements of another type.
+	 */
+	explicit mapped_fixture(const std::string& filename) : m_file{ filename }
+	{
+		if (m_file.size() < sizeof m_header)
+			throw std::runtime_error{ filename + " : not a fixture file!\n" };
+		std::memcpy(&m_header, m_file.data(), sizeof m_header);
+		detail::check_fixture_header(m_header, detail::fixture_type_of<T>(), sizeof(T), filename);
+		if (m_file.size() - sizeof m_header < m_header.count * sizeof(T))
+			throw std::runtime_error{ filename + " : unexpected end of fixture file!\n" };
+	}
+
+	[[nodiscard]] const fixture_header& header() const noexcept
+	{
+		return m_header;
+	}
+
+	[[nodiscard]] std::span<const T> data() const noexcept
+	{
+		return { reinterpret_cast<const T*>(m_file.data() + sizeof m_header), static_cast<std::size_t>(m_header.count) };
+	}
+
+private:
+	mapped_file m_file;
+	fixture_header m_header;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Maps a fixture file saved by `save_fixture` into memory.
+ *
+ * @tparam T The element type the file was saved with.
+ * @param filename The name of the fixture file.
+ */
+template<typename T>
+[[nodiscard]] mapped_fixture<T> map_fixture(const std::string& filename)
+{
+	return mapped_fixture<T>{ filename };
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   benchmarking   */
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of `val`.
+ *
+ * The value is treated as if it were read by code the optimizer cannot see.
+ *
+ * @example
+ * @code
+ * benchmark("accumulate", [&] { do_not_optimize(std::accumulate(v.begin(), v.end(), 0LL)); });
+ * @endcode
+ */
+template<typename T>
+inline void do_not_optimize(const T& val)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(val) : "memory");
+#else
+	static const void* volatile sink;
+	sink = &val;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Prevents the compiler from optimizing away the computation of `val` and from assuming
+ *        that `val` is unchanged afterwards.
+ */
+template<typename T>
+inline void do_not_optimize(T& val)
+{
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(__clang__)
+	asm volatile("" : "+r,m"(val) : : "memory");
+#else
+	asm volatile("" : "+m,r"(val) : : "memory");
+#endif
+#else
+	static void* volatile sink;
+	sink = &val;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Forces all pending writes to memory to be treated as observable.
+ */
+inline void clobber_memory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : : "memory");
+#else
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Options of a benchmark run.
+ */
+struct bench_options {
+	std::size_t warmup = 3;       ///< untimed repetitions before the measurement
+	std::size_t repetitions = 31; ///< timed repetitions (samples)
+	std::size_t iterations = 0;   ///< calls per repetition, 0: calibrated so that a repetition takes at least `min_time`
+	std::size_t elements = 1;     ///< elements processed by one call, used for the per-element figures
+	std::chrono::nanoseconds min_time = std::chrono::milliseconds{ 1 };
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief The statistics of a benchmark run; all times are per call in nanoseconds.
+ */
+struct bench_result {
+	std::string name;
+	std::size_t repetitions = 0;
+	std::size_t iterations = 0;
+	std::size_t elements = 1;
+	double min_ns = 0;
+	double median_ns = 0;
+	double mean_ns = 0;
+	double p99_ns = 0;
+	double max_ns = 0;
+
+	[[nodiscard]] double ns_per_element() const noexcept
+	{
+		return median_ns / static_cast<double>(elements);
+	}
+
+	[[nodiscard]] double elements_per_second() const noexcept
+	{
+		return median_ns > 0 ? 1e9 * static_cast<double>(elements) / median_ns : 0;
+	}
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Inserts one line with the statistics of a benchmark run into an output stream.
+ *
+ * The columns are: name, minimum, median, 99th percentile (all per call), median time per
+ * element and elements per second.
+ */
+inline std::ostream& operator<<(std::ostream& os, const bench_result& r)
+{
+	const auto flags = os.flags();
+	const auto prec = os.precision();
+	os << std::left << std::setw(32) << r.name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(14) << r.min_ns << std::setw(14) << r.median_ns << std::setw(14) << r.p99_ns
+		<< std::setw(12) << std::setprecision(3) << r.ns_per_element()
+		<< std::setw(12) << std::setprecision(2) << r.elements_per_second() / 1e6;
+	os.flags(flags);
+	os.precision(prec);
+	return os;
+}
+
+namespace detail {
+
+	[[nodiscard]] inline bench_result bench_statistics(std::string name, std::vector<double> samples, std::size_t iterations, std::size_t elements)
+	{
+		std::sort(samples.begin(), samples.end());
+		bench_result r;
+		r.name = std::move(name);
+		r.repetitions = samples.size();
+		r.iterations = iterations;
+		r.elements = std::max<std::size_t>(elements, 1);
+		if (samples.empty())
+			return r;
+
+		const std::size_t n = samples.size();
+		r.min_ns = samples.front();
+		r.max_ns = samples.back();
+		r.median_ns = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+		r.p99_ns = samples[std::min(n - 1, (n * 99 + 99) / 100 - 1)];
+		double sum = 0;
+		for (const double x : samples)
+			sum += x;
+		r.mean_ns = sum / static_cast<double>(n);
+		return r;
+	}
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Measures the running time of a callable.
+ *
+ * After `opt.warmup` untimed repetitions, `opt.repetitions` samples are taken. Each sample
+ * times `opt.iterations` consecutive calls (calibrated automatically by default, so that very
+ * short operations are not dominated by the clock resolution) and is divided by that number.
+ *
+ * @param name The name shown in the report.
+ * @param f The callable to be measured. Use `do_not_optimize` on its results.
+ * @param opt The options of the run.
+ * @return The statistics of the run.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * rfill(ivec, 1'000'000, Irand{ 0, 1000 });
+ * auto r = benchmark("accumulate", [&] { do_not_optimize(std::accumulate(ivec.begin(), ivec.end(), 0LL)); },
+ *     { .elements = ivec.size() });
+ * std::cout << r << dash_line;
+ * @endcode
+ */
+template<typename F>
+[[nodiscard]] bench_result benchmark(std::string name, F f, bench_options opt = {})
+{
+	using clock = std::chrono::steady_clock;
+
+	std::size_t iterations = opt.iterations;
+	if (iterations == 0) {
+		for (iterations = 1; ; iterations *= 2) {
+			const auto start = clock::now();
+			for (std::size_t i = 0; i < iterations; ++i)
+				f();
+			if (clock::now() - start >= opt.min_time || iterations >= (std::size_t{ 1 } << 30))
+				break;
+		}
+	}
+
+	for (std::size_t i = 0; i < opt.warmup; ++i)
+		f();
+
+	std::vector<double> samples;
+	samples.reserve(opt.repetitions);
+	for (std::size_t rep = 0; rep < opt.repetitions; ++rep) {
+		const auto start = clock::now();
+		for (std::size_t i = 0; i < iterations; ++i)
+			f();
+		const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+		samples.push_back(elapsed.count() / static_cast<double>(iterations));
+	}
+
+	return detail::bench_statistics(std::move(name), std::move(samples), iterations, opt.elements);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Measures the running time of a callable on a fresh input for every repetition.
+ *
+ * `setup()` is called before every repetition, untimed, and its result is passed to `f`,
+ * which is timed. This suits operations that consume or modify their input, e.g. sorting.
+ * The iteration count of `opt` is ignored; every sample is one call.
+ *
+ * @param name The name shown in the report.
+ * @param setup Creates the input of a repetition, e.g. `rfill_input<std::vector<int>>(n, Irand{ 0, 100 })`.
+ * @param f The callable to be measured, taking the input by reference.
+ * @param opt The options of the run.
+ *
+ * @example
+ * @code
+ * auto r = benchmark("std::sort", rfill_input<std::vector<int>>(1'000'000, Irand{ 0, 1'000'000 }),
+ *     [](auto& v) { std::sort(v.begin(), v.end()); }, { .elements = 1'000'000 });
+ * @endcode
+ */
+template<typename Setup, typename F>
+	requires std::invocable<Setup&>
+[[nodiscard]] bench_result benchmark(std::string name, Setup setup, F f, bench_options opt = {})
+{
+	using clock = std::chrono::steady_clock;
+
+	for (std::size_t i = 0; i < opt.warmup; ++i) {
+		auto input = setup();
+		f(input);
+	}
+
+	std::vector<double> samples;
+	samples.reserve(opt.repetitions);
+	for (std::size_t rep = 0; rep < opt.repetitions; ++rep) {
+		auto input = setup();
+		clobber_memory();
+		const auto start = clock::now();
+		f(input);
+		clobber_memory();
+		const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+		samples.push_back(elapsed.count());
+		do_not_optimize(input);
+	}
+
+	return detail::bench_statistics(std::move(name), std::move(samples), 1, opt.elements);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Returns a setup callable for `benchmark` creating a container filled by `rfill`.
+ *
+ * @tparam Container The type of the container to be created.
+ * @param n The number of elements.
+ * @param frand The random function passed to `rfill`.
+ */
+template<typename Container, typename Random>
+[[nodiscard]] auto rfill_input(std::size_t n, Random frand)
+{
+	return [n, frand] {
+		Container c;
+		rfill(c, n, frand);
+		return c;
+	};
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Prints the results of several benchmark runs as a table framed by dash lines.
+ *
+ * @param results The results to be printed.
+ * @param os The output stream. The default is `std::cout`.
+ */
+inline void print_benchmarks(const std::vector<bench_result>& results, std::ostream& os = std::cout)
+{
+	const auto flags = os.flags();
+	os << std::left << std::setw(32) << "benchmark" << std::right << std::setw(14) << "min (ns)" << std::setw(14) << "median (ns)"
+		<< std::setw(14) << "p99 (ns)" << std::setw(12) << "ns/elem" << std::setw(12) << "Melem/s" << dash_line;
+	os.flags(flags);
+	print(results, "\n", os);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   hardware performance counters   */
+
+/**
+ * @brief The counter values recorded for a code region.
+ *
+ * A counter that could not be read on the current platform is marked as unavailable
+ * (see `has`); it is printed as `n/a`.
+ */
+struct perf_sample {
+	enum counter : unsigned {
+		cycles_bit = 1,
+		instructions_bit = 2,
+		cache_misses_bit = 4,
+		branch_misses_bit = 8,
+		tsc_bit = 16, ///< `cycles` holds time stamp counter ticks instead of core cycles
+	};
+
+	std::string name;
+	double nanoseconds = 0;
+	std::uint64_t cycles = 0;
+	std::uint64_t instructions = 0;
+	std::uint64_t cache_misses = 0;
+	std::uint64_t branch_misses = 0;
+	unsigned available = 0; ///< combination of the `counter` bits
+
+	[[nodiscard]] bool has(counter c) const noexcept
+	{
+		return (available & c) != 0;
+	}
+
+	/**
+	 * @brief Instructions per cycle, 0 if not available.
+	 */
+	[[nodiscard]] double ipc() const noexcept
+	{
+		return has(instructions_bit) && has(cycles_bit) && cycles ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.;
+	}
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Inserts one line with the values of a `perf_sample` into an output stream.
+ */
+inline std::ostream& operator<<(std::ostream& os, const perf_sample& s)
+{
+	const auto flags = os.flags();
+	const auto prec = os.precision();
+	auto field = [&](bool valid, std::uint64_t val) {
+		if (valid)
+			os << std::setw(16) << val;
+		else
+			os << std::setw(16) << "n/a";
+	};
+
+	os << std::left << std::setw(28) << s.name << std::right << std::fixed << std::setprecision(0) << std::setw(14) << s.nanoseconds;
+	field(s.has(perf_sample::cycles_bit) || s.has(perf_sample::tsc_bit), s.cycles);
+	field(s.has(perf_sample::instructions_bit), s.instructions);
+	field(s.has(perf_sample::cache_misses_bit), s.cache_misses);
+	field(s.has(perf_sample::branch_misses_bit), s.branch_misses);
+	os << std::setw(8) << std::setprecision(2) << s.ipc();
+	os.flags(flags);
+	os.precision(prec);
+	return os;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class perf_counters
+ * @brief Reads cycles, instructions, cache misses and branch misses of the calling thread.
+ *
+ * On Linux the counters are opened as one `perf_event_open` group (user space only), so all
+ * values refer to exactly the same interval; multiplexed counters are scaled. If the counters
+ * are not accessible (no PMU in a virtual machine, `perf_event_paranoid` too strict, other
+ * operating systems), only the elapsed time and, on x86, the time stamp counter are recorded.
+ * The elapsed time is measured with `std::chrono::steady_clock` (QueryPerformanceCounter on Windows).
+ */
+
+class perf_counters {
+public:
+	perf_counters()
+	{
+#if defined(__linux__)
+		constexpr std::pair<std::uint32_t, std::uint64_t> events[] = {
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+		};
+		for (std::size_t i = 0; i < std::size(events); ++i) {
+			perf_event_attr attr{};
+			attr.size = sizeof attr;
+			attr.type = events[i].first;
+			attr.config = events[i].second;
+			attr.disabled = m_leader < 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0));
+			if (fd < 0)
+				continue;
+			if (m_leader < 0)
+				m_leader = fd;
+			m_fds[m_nfds] = fd;
+			m_bits[m_nfds++] = 1u << i;
+		}
+#endif
+	}
+
+	perf_counters(const perf_counters&) = delete;
+	perf_counters& operator=(const perf_counters&) = delete;
+
+	~perf_counters()
+	{
+#if defined(__linux__)
+		for (std::size_t i = 0; i < m_nfds; ++i)
+			::close(m_fds[i]);
+#endif
+	}
+
+	/**
+	 * @brief Returns `true` if at least one hardware counter could be opened.
+	 */
+	[[nodiscard]] bool hardware_available() const noexcept
+	{
+		return m_nfds != 0;
+	}
+
+	void start() noexcept
+	{
+#if defined(__linux__)
+		if (m_leader >= 0) {
+			::ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			::ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+#endif
+		m_tsc = read_tsc();
+		m_start = std::chrono::steady_clock::now();
+	}
+
+	[[nodiscard]] perf_sample stop(std::string name = {}) noexcept
+	{
+		const auto end = std::chrono::steady_clock::now();
+		const std::uint64_t tsc = read_tsc();
+		perf_sample s;
+#if defined(__linux__)
+		if (m_leader >= 0) {
+			::ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+			std::uint64_t buf[3 + max_counters]{};
+			if (::read(m_leader, buf, sizeof buf) > 0) {
+				const double scale = buf[2] ? static_cast<double>(buf[1]) / static_cast<double>(buf[2]) : 1.;
+				for (std::size_t i = 0; i < m_nfds && i < buf[0]; ++i) {
+					const auto val = static_cast<std::uint64_t>(static_cast<double>(buf[3 + i]) * scale);
+					switch (m_bits[i]) {
+					case perf_sample::cycles_bit: s.cycles = val; break;
+					case perf_sample::instructions_bit: s.instructions = val; break;
+					case perf_sample::cache_misses_bit: s.cache_misses = val; break;
+					case perf_sample::branch_misses_bit: s.branch_misses = val; break;
+					}
+					s.available |= m_bits[i];
+				}
+			}
+		}
+#endif
+		if (!s.has(perf_sample::cycles_bit) && tsc_supported) {
+			s.cycles = tsc - m_tsc;
+			s.available |= perf_sample::tsc_bit;
+		}
+		s.name = std::move(name);
+		s.nanoseconds = std::chrono::duration<double, std::nano>(end - m_start).count();
+		return s;
+	}
+
+private:
+	static constexpr std::size_t max_counters = 4;
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	static constexpr bool tsc_supported = true;
+#else
+	static constexpr bool tsc_supported = false;
+#endif
+
+	[[nodiscard]] static std::uint64_t read_tsc() noexcept
+	{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	int m_leader = -1;
+	int m_fds[max_counters]{};
+	unsigned m_bits[max_counters]{};
+	std::size_t m_nfds = 0;
+	std::uint64_t m_tsc = 0;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+namespace detail {
+
+	[[nodiscard]] inline perf_counters& thread_perf_counters()
+	{
+		thread_local perf_counters counters;
+		return counters;
+	}
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class perf_region
+ * @brief Records the performance counters of the enclosing scope.
+ *
+ * The counters start in the constructor and stop in the destructor, which appends the
+ * sample to the given vector. Regions must not be nested within one thread, since every
+ * thread has one set of counters.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * fcs(ivec, 1'000'000, Irand{ 0, 10'000'000 });
+ * std::set<int> iset(ivec.begin(), ivec.end());
+ *
+ * std::vector<perf_sample> samples;
+ * {
+ *     perf_region r{ "set lookup", samples };
+ *     for (int i = 0; i < 1'000'000; ++i) do_not_optimize(iset.find(i));
+ * }
+ * {
+ *     perf_region r{ "sorted vector lookup", samples };
+ *     for (int i = 0; i < 1'000'000; ++i) do_not_optimize(std::lower_bound(ivec.begin(), ivec.end(), i));
+ * }
+ * print_perf(samples);
+ * @endcode
+ */
+
+class perf_region {
+public:
+	perf_region(std::string name, std::vector<perf_sample>& out) : m_name{ std::move(name) }, m_out{ out }
+	{
+		detail::thread_perf_counters().start();
+	}
+
+	perf_region(const perf_region&) = delete;
+	perf_region& operator=(const perf_region&) = delete;
+
+	~perf_region()
+	{
+		auto s = detail::thread_perf_counters().stop(std::move(m_name));
+		try {
+			m_out.push_back(std::move(s));
+		}
+		catch (...) {
+		}
+	}
+
+private:
+	std::string m_name;
+	std::vector<perf_sample>& m_out;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @brief Prints performance counter samples as a table framed by dash lines.
+ *
+ * @param samples The samples to be printed.
+ * @param os The output stream. The default is `std::cout`.
+ */
+inline void print_perf(const std::vector<perf_sample>& samples, std::ostream& os = std::cout)
+{
+	const auto flags = os.flags();
+	os << std::left << std::setw(28) << "region" << std::right << std::setw(14) << "ns" << std::setw(16) << "cycles"
+		<< std::setw(16) << "instructions" << std::setw(16) << "cache misses" << std::setw(16) << "branch misses"
+		<< std::setw(8) << "IPC" << dash_line;
+	os.flags(flags);
+	print(samples, "\n", os);
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   allocation statistics and arena allocators   */
+
+/**
+ * @brief Allocation statistics collected by `counting_allocator`, `counting_resource` and `arena`.
+ *
+ * `reserved_bytes` is the memory an arena has obtained from its upstream resource; allocators
+ * that pass every request straight to their upstream leave it at 0. The statistics are not
+ * synchronized, one object should be used by one thread.
+ */
+struct alloc_stats {
+	std::size_t allocations = 0;
+	std::size_t deallocations = 0;
+	std::size_t bytes_allocated = 0; ///< total number of bytes requested
+	std::size_t current_bytes = 0;   ///< bytes currently in use
+	std::size_t peak_bytes = 0;      ///< maximum of `current_bytes`
+	std::size_t reserved_bytes = 0;  ///< bytes held by an arena
+
+	void on_allocate(std::size_t bytes) noexcept
+	{
+		++allocations;
+		bytes_allocated += bytes;
+		current_bytes += bytes;
+		if (current_bytes > peak_bytes)
+			peak_bytes = current_bytes;
+	}
+
+	void on_deallocate(std::size_t bytes) noexcept
+	{
+		++deallocations;
+		current_bytes -= bytes;
+	}
+
+	/**
+	 * @brief The fraction of the reserved memory that is not in use, 0 without reserved memory.
+	 */
+	[[nodiscard]] double fragmentation() const noexcept
+	{
+		return reserved_bytes > current_bytes ? 1. - static_cast<double>(current_bytes) / static_cast<double>(reserved_bytes) : 0.;
+	}
+
+	void reset() noexcept
+	{
+		*this = alloc_stats{};
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& os, const alloc_stats& st)
+{
+	const auto flags = os.flags();
+	const auto prec = os.precision();
+	os << "allocations: " << st.allocations << "  deallocations: " << st.deallocations << "  bytes: " << st.bytes_allocated
+		<< "  current: " << st.current_bytes << "  peak: " << st.peak_bytes << "  reserved: " << st.reserved_bytes
+		<< "  fragmentation: " << std::fixed << std::setprecision(1) << st.fragmentation() * 100 << '%';
+	os.flags(flags);
+	os.precision(prec);
+	return os;
+}
+
+/**
+ * @brief The statistics used by default constructed `counting_allocator` objects.
+ */
+[[nodiscard]] inline alloc_stats& global_alloc_stats() noexcept
+{
+	static alloc_stats stats;
+	return stats;
+}
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class counting_allocator
+ * @brief An allocator that counts the allocations and bytes requested by a container.
+ *
+ * Memory is obtained with `std::allocator`. Allocators rebound from each other (e.g. the node
+ * allocator of a `std::list`) share the same statistics object.
+ *
+ * @example
+ * @code
+ * alloc_stats st;
+ * std::list<int, counting_allocator<int>> mylist{ counting_allocator<int>{ st } };
+ * rfill(mylist, 100'000, Irand{ 0, 1000 });
+ * std::cout << st << '\n';
+ * @endcode
+ */
+
+template<typename T>
+class counting_allocator {
+public:
+	using value_type = T;
+
+	counting_allocator() noexcept : m_stats{ &global_alloc_stats() } {}
+	explicit counting_allocator(alloc_stats& stats) noexcept : m_stats{ &stats } {}
+
+	template<typename U>
+	counting_allocator(const counting_allocator<U>& other) noexcept : m_stats{ &other.stats() } {}
+
+	[[nodiscard]] T* allocate(std::size_t n)
+	{
+		T* p = std::allocator<T>{}.allocate(n);
+		m_stats->on_allocate(n * sizeof(T));
+		return p;
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept
+	{
+		m_stats->on_deallocate(n * sizeof(T));
+		std::allocator<T>{}.deallocate(p, n);
+	}
+
+	[[nodiscard]] alloc_stats& stats() const noexcept
+	{
+		return *m_stats;
+	}
+
+	template<typename U>
+	friend bool operator==(const counting_allocator& a, const counting_allocator<U>& b) noexcept
+	{
+		return &a.stats() == &b.stats();
+	}
+
+private:
+	alloc_stats* m_stats;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class counting_resource
+ * @brief A `std::pmr::memory_resource` that counts the requests passed to its upstream resource.
+ *
+ * @example
+ * @code
+ * counting_resource res;
+ * std::pmr::set<int> myset{ &res };
+ * rfill(myset, 10'000, Irand{ 0, 100'000 });
+ * std::cout << res.stats() << '\n';
+ * @endcode
+ */
+
+class counting_resource : public std::pmr::memory_resource {
+public:
+	explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept : m_upstream{ upstream } {}
+
+	counting_resource(const counting_resource&) = delete;
+	counting_resource& operator=(const counting_resource&) = delete;
+
+	[[nodiscard]] const alloc_stats& stats() const noexcept
+	{
+		return m_stats;
+	}
+
+	void reset_stats() noexcept
+	{
+		m_stats.reset();
+	}
+
+	[[nodiscard]] std::pmr::memory_resource* upstream() const noexcept
+	{
+		return m_upstream;
+	}
+
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		void* p = m_upstream->allocate(bytes, alignment);
+		m_stats.on_allocate(bytes);
+		return p;
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+		m_stats.on_deallocate(bytes);
+		m_upstream->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	std::pmr::memory_resource* m_upstream;
+	alloc_stats m_stats;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class arena
+ * @brief A monotonic arena with free lists for small blocks, usable as a `std::pmr::memory_resource`.
+ *
+ * Memory is taken from large blocks of the upstream resource by bumping a pointer. Freed
+ * requests of up to `max_pooled` bytes are kept in per size class free lists and reused by
+ * later requests of the same class, so node based containers (`std::list`, `std::set`,
+ * `std::forward_list`) that erase and insert do not make the arena grow. Larger requests are
+ * released only with `release()` or the destruction of the arena. The memory in use, the
+ * reserved memory and the resulting fragmentation are reported by `stats()`.
+ *
+ * @example
+ * @code
+ * arena ar;
+ * std::pmr::list<int> mylist{ &ar };
+ * rfill(mylist, 100'000, Irand{ 0, 1000 });
+ * std::cout << ar.stats() << '\n';
+ * @endcode
+ */
+
+class arena : public std::pmr::memory_resource {
+public:
+	static constexpr std::size_t granularity = 16;
+	static constexpr std::size_t max_pooled = 256;
+
+	explicit arena(std::size_t block_size = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+		: m_upstream{ upstream }, m_block_size{ block_size < 1024 ? 1024 : block_size } {}
+
+	arena(const arena&) = delete;
+	arena& operator=(const arena&) = delete;
+
+	~arena()
+	{
+		release();
+	}
+
+	/**
+	 * @brief Returns all memory to the upstream resource. The memory allocated from the arena must no longer be used.
+	 */
+	void release() noexcept
+	{
+		while (m_blocks) {
+			block* next = m_blocks->next;
+			m_upstream->deallocate(m_blocks, m_blocks->size, alignof(std::max_align_t));
+			m_blocks = next;
+		}
+		m_cur = m_end = nullptr;
+		for (auto& head : m_free)
+			head = nullptr;
+		m_stats.reset();
+	}
+
+	[[nodiscard]] const alloc_stats& stats() const noexcept
+	{
+		return m_stats;
+	}
+
+	[[nodiscard]] std::pmr::memory_resource* upstream() const noexcept
+	{
+		return m_upstream;
+	}
+
+private:
+	struct block {
+		block* next;
+		std::size_t size;
+	};
+
+	struct free_node {
+		free_node* next;
+	};
+
+	static constexpr std::size_t header_size = (sizeof(block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+	[[nodiscard]] static constexpr bool pooled(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		return bytes <= max_pooled && alignment <= granularity;
+	}
+
+	[[nodiscard]] static constexpr std::size_t size_class(std::size_t bytes) noexcept
+	{
+		return bytes ? (bytes - 1) / granularity : 0;
+	}
+
+	void* bump(std::size_t bytes, std::size_t alignment)
+	{
+		auto p = reinterpret_cast<std::uintptr_t>(m_cur);
+		p = (p + alignment - 1) & ~(alignment - 1);
+		if (!m_cur || p + bytes > reinterpret_cast<std::uintptr_t>(m_end)) {
+			const std::size_t need = header_size + bytes + alignment;
+			const std::size_t size = need > m_block_size ? need : m_block_size;
+			auto b = static_cast<block*>(m_upstream->allocate(size, alignof(std::max_align_t)));
+			b->next = m_blocks;
+			b->size = size;
+			m_blocks = b;
+			m_stats.reserved_bytes += size;
+			m_cur = reinterpret_cast<std::byte*>(b) + header_size;
+			m_end = reinterpret_cast<std::byte*>(b) + size;
+			p = reinterpret_cast<std::uintptr_t>(m_cur);
+			p = (p + alignment - 1) & ~(alignment - 1);
+		}
+		m_cur = reinterpret_cast<std::byte*>(p + bytes);
+		return reinterpret_cast<void*>(p);
+	}
+
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		void* p;
+		if (pooled(bytes, alignment)) {
+			const std::size_t cls = size_class(bytes);
+			bytes = (cls + 1) * granularity;
+			if (m_free[cls]) {
+				p = m_free[cls];
+				m_free[cls] = m_free[cls]->next;
+			}
+			else
+				p = bump(bytes, granularity);
+		}
+		else
+			p = bump(bytes, alignment);
+		m_stats.on_allocate(bytes);
+		return p;
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+	{
+		if (pooled(bytes, alignment)) {
+			const std::size_t cls = size_class(bytes);
+			bytes = (cls + 1) * granularity;
+			m_free[cls] = ::new (p) free_node{ m_free[cls] };
+		}
+		m_stats.on_deallocate(bytes);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	std::pmr::memory_resource* m_upstream;
+	std::size_t m_block_size;
+	block* m_blocks = nullptr;
+	std::byte* m_cur = nullptr;
+	std::byte* m_end = nullptr;
+	free_node* m_free[max_pooled / granularity]{};
+	alloc_stats m_stats;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+/**
+ * @class arena_allocator
+ * @brief A classic allocator that takes its memory from an `arena`.
+ *
+ * For pmr containers the `arena` itself can be passed as the memory resource.
+ *
+ * @example
+ * @code
+ * arena ar;
+ * std::set<int, std::less<>, arena_allocator<int>> myset{ arena_allocator<int>{ ar } };
+ * fcs(myset, 10'000, Irand{ 0, 100'000 });
+ * std::cout << ar.stats() << '\n';
+ * @endcode
+ */
+
+template<typename T>
+class arena_allocator {
+public:
+	using value_type = T;
+
+	explicit arena_allocator(arena& ar) noexcept : m_arena{ &ar } {}
+
+	template<typename U>
+	arena_allocator(const arena_allocator<U>& other) noexcept : m_arena{ &other.get_arena() } {}
+
+	[[nodiscard]] T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, std::size_t n) noexcept
+	{
+		m_arena->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	[[nodiscard]] arena& get_arena() const noexcept
+	{
+		return *m_arena;
+	}
+
+	template<typename U>
+	friend bool operator==(const arena_allocator& a, const arena_allocator<U>& b) noexcept
+	{
+		return &a.get_arena() == &b.get_arena();
+	}
+
+private:
+	arena* m_arena;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   pre-generated random pools   */
+
+namespace detail {
+
+	template<typename T>
+	struct cache_aligned_allocator {
+		using value_type = T;
+
+		static constexpr std::align_val_t alignment{ alignof(T) > cache_line_size ? alignof(T) : cache_line_size };
+
+		cache_aligned_allocator() noexcept = default;
+
+		template<typename U>
+		cache_aligned_allocator(const cache_aligned_allocator<U>&) noexcept {}
+
+		[[nodiscard]] T* allocate(std::size_t n)
+		{
+			return static_cast<T*>(::operator new(n * sizeof(T), alignment));
+		}
+
+		void deallocate(T* p, std::size_t) noexcept
+		{
+			::operator delete(p, alignment);
+		}
+
+		template<typename U>
+		friend bool operator==(const cache_aligned_allocator&, const cache_aligned_allocator<U>&) noexcept
+		{
+			return true;
+		}
+	};
+}
+
+/**
+ * @class random_pool
+ * @brief A block of values generated in advance, to be replayed inside a timed loop.
+ *
+ * The values are generated once with `rfill` (so the bulk `generate` paths of `Irand`, `Drand`,
+ * ... are used) and stored contiguously, starting at a cache line boundary. `next()` hands them
+ * out cyclically. For multithreaded benchmarks every thread takes its own `cursor`; cursors are
+ * cache line sized, so an array of them shares no cache line and the pool itself is only read.
+ *
+ * @tparam T The type of the values.
+ *
+ * @example
+ * @code
+ * std::unordered_set<int> myset;
+ * random_pool<int> keys{ 1 << 20, Irand{ 0, 1'000'000 } };
+ * benchmark("insert", [&] { myset.insert(keys.next()); });
+ *
+ * random_pool<std::string> names{ 10'000, random_name };
+ * auto cursors = names.cursors(4);
+ * // thread i: for (...) use(cursors[i].next());
+ * @endcode
+ */
+
+template<typename T>
+class random_pool {
+public:
+	using value_type = T;
+
+	/**
+	 * @class cursor
+	 * @brief A cyclic read position in a pool, occupying a cache line of its own.
+	 */
+	class alignas(detail::cache_line_size) cursor {
+	public:
+		cursor() = default;
+
+		[[nodiscard]] const T& next() noexcept
+		{
+			const T& val = m_first[m_pos];
+			if (++m_pos == m_size)
+				m_pos = 0;
+			return val;
+		}
+
+		[[nodiscard]] std::size_t position() const noexcept
+		{
+			return m_pos;
+		}
+
+	private:
+		friend class random_pool;
+
+		cursor(const T* first, std::size_t size, std::size_t pos) noexcept : m_first{ first }, m_size{ size }, m_pos{ pos } {}
+
+		const T* m_first = nullptr;
+		std::size_t m_size = 0;
+		std::size_t m_pos = 0;
+	};
+
+	/**
+	 * @brief Generates `n` values with `gen`.
+	 *
+	 * @param n The number of values, at least 1.
+	 * @param gen A generator callable with no arguments (`Irand`, `Drand`, `random_name`, ...).
+	 */
+	template<typename Gen>
+	random_pool(std::size_t n, Gen gen)
+	{
+		if (n == 0)
+			throw std::invalid_argument{ "random_pool : the pool cannot be empty!\n" };
+		rfill(m_values, n, std::move(gen));
+		m_cursor = make_cursor();
+	}
+
+	random_pool(const random_pool&) = delete;
+	random_pool& operator=(const random_pool&) = delete;
+
+	/**
+	 * @brief Returns the next value; after the last one the pool starts over.
+	 */
+	[[nodiscard]] const T& next() noexcept
+	{
+		return m_cursor.next();
+	}
+
+	/**
+	 * @brief Returns a cursor starting at `pos % size()`.
+	 */
+	[[nodiscard]] cursor make_cursor(std::size_t pos = 0) const noexcept
+	{
+		return cursor{ m_values.data(), m_values.size(), pos % m_values.size() };
+	}
+
+	/**
+	 * @brief Returns `count` cursors whose start positions are spread evenly over the pool.
+	 */
+	[[nodiscard]] std::vector<cursor> cursors(std::size_t count) const
+	{
+		std::vector<cursor> vec;
+		vec.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+			vec.push_back(make_cursor(i * m_values.size() / count));
+		return vec;
+	}
+
+	void rewind() noexcept
+	{
+		m_cursor = make_cursor();
+	}
+
+	[[nodiscard]] std::span<const T> values() const noexcept
+	{
+		return m_values;
+	}
+
+	[[nodiscard]] const T* data() const noexcept
+	{
+		return m_values.data();
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return m_values.size();
+	}
+
+	[[nodiscard]] const T& operator[](std::size_t idx) const noexcept
+	{
+		return m_values[idx];
+	}
+
+private:
+	std::vector<T, detail::cache_aligned_allocator<T>> m_values;
+	cursor m_cursor;
+};
+
+//------------------------------------------------------
+//------------------------------------------------------
+
+/*   data patterns   */
+
+/**
+ * @brief The input patterns `fill_pattern` can produce.
+ */
+enum class data_pattern {
+	random,       ///< uniform values in [0, n)
+	ascending,    ///< 0, 1, ..., n - 1
+	descending,   ///< n - 1, ..., 1, 0
+	organ_pipe,   ///< ascending up to the middle, then descending
+	sawtooth,     ///< ascending runs of `period` elements
+	few_unique,   ///< uniform values in [0, unique)
+	k_sorted,     ///< ascending, shuffled within blocks of `k`: no element is `k` or more places away from its sorted position
+	random_swaps, ///< ascending, then `swap_fraction * n` random pairs swapped
+};
+
+inline constexpr data_pattern all_data_patterns[] = {
+	data_pattern::random, data_pattern::ascending, data_pattern::descending, data_pattern::organ_pipe,
+	data_pattern::sawtooth, data_pattern::few_unique, data_pattern::k_sorted, data_pattern::random_swaps,
+};
+
+[[nodiscard]] constexpr std::string_view pattern_name(data_pattern p) noexcept
+{
+	switch (p) {
+	case data_pattern::random: return "random";
+	case data_pattern::ascending: return "ascending";
+	case data_pattern::descending: return "descending";
+	case data_pattern::organ_pipe: return "organ pipe";
+	case data_pattern::sawtooth: return "sawtooth";
+	case data_pattern::few_unique: return "few unique";
+	case data_pattern::k_sorted: return "k-sorted";
+	case data_pattern::random_swaps: return "random swaps";
+	}
+	return "unknown";
+}
+
+inline std::ostream& operator<<(std::ostream& os, data_pattern p)
+{
+	return os << pattern_name(p);
+}
+
+/**
+ * @brief The parameters of the patterns; only the ones of the requested pattern are used.
+ */
+struct pattern_options {
+	std::size_t period = 1024;          ///< `sawtooth`: the length of a run
+	std::size_t unique = 16;            ///< `few_unique`: the number of distinct values
+	std::size_t k = 16;                 ///< `k_sorted`: the block size
+	double swap_fraction = 0.01;        ///< `random_swaps`: the number of swapped pairs relative to `n`
+	std::optional<std::uint64_t> seed;  ///< seed of the random patterns, by default a draw of `fast_urng()`
+	unsigned threads = 1;               ///< the number of threads
+};
+
+/**
+ * @brief Writes a data pattern into contiguous storage in O(n).
+ *
+ * The deterministic patterns are computed from the index of each element; the random ones use
+ * an engine per chunk seeded from `opt.seed`, so the output is reproducible for a given seed and
+ * number of threads. With `opt.threads > 1` the work is split into contiguous chunks.
+ *
+ * @tparam T An arithmetic type.
+ * @param out The elements to be written.
+ * @param p The pattern.
+ * @param opt The parameters of the pattern.
+ *
+ * @example
+ * @code
+ * std::vector<int> ivec(10'000'000);
+ * fill_pattern(std::span{ ivec }, data_pattern::k_sorted, { .k = 64, .threads = 4 });
+ * @endcode
+ */
+template<typename T>
+	requires std::is_arithmetic_v<T>
+void fill_pattern(std::span<T> out, data_pattern p, const pattern_options& opt = {})
+{
+	const std::size_t n = out.size();
+	if (n == 0)
+		return;
+	const std::uint64_t seed = opt.seed ? *opt.seed : fast_urng()();
+	const unsigned parts = std::max(1u, opt.threads);
+
+	auto for_chunks = [&](auto task) {
+		detail::run_chunks(0, n, parts, [&](unsigned idx, std::size_t lo, std::size_t hi) { task(idx, lo, hi); });
+	};
+	auto ascending = [&] {
+		for_chunks([&](unsigned, std::size_t lo, std::size_t hi) {
+			for (std::size_t i = lo; i < hi; ++i)
+				out[i] = static_cast<T>(i);
+		});
+	};
+	auto uniform = [&](std::uint64_t range) {
+		for_chunks([&](unsigned idx, std::size_t lo, std::size_t hi) {
+			xoshiro256ss eng{ detail::chunk_seed(seed, idx) };
+			for (std::size_t i = lo; i < hi; ++i)
+				out[i] = static_cast<T>(static_cast<std::size_t>(detail::bounded(range, eng)));
+		});
+	};
+
+	switch (p) {
+	case data_pattern::random:
+		uniform(n);
+		break;
+	case data_pattern::ascending:
+		ascending();
+		break;
+	case data_pattern::descending:
+		for_chunks([&](unsigned, std::size_t lo, std::size_t hi) {
+			for (std::size_t i = lo; i < hi; ++i)
+				out[i] = static_cast<T>(n - 1 - i);
+		});
+		break;
+	case data_pattern::organ_pipe:
+		for_chunks([&](unsigned, std::size_t lo, std::size_t hi) {
+			for (std::size_t i = lo; i < hi; ++i)
+				out[i] = static_cast<T>(i < n / 2 ? i : n - 1 - i);
+		});
+		break;
+	case data_pattern::sawtooth: {
+		const std::size_t period = std::max<std::size_t>(1, opt.period);
+		for_chunks([&](unsigned, std::size_t lo, std::size_t hi) {
+			std::size_t v = lo % period;
+			for (std::size_t i = lo; i < hi; ++i) {
+				out[i] = static_cast<T>(v);
+				if (++v == period)
+					v = 0;
+			}
+		});
+		break;
+	}
+	case data_pattern::few_unique:
+		uniform(std::max<std::size_t>(1, opt.unique));
+		break;
+	case data_pattern::k_sorted: {
+		ascending();
+		const std::size_t k = std::max<std::size_t>(1, opt.k);
+		detail::run_chunks(0, (n + k - 1) / k, parts, [&](unsigned idx, std::size_t lo, std::size_t hi) {
+			xoshiro256ss eng{ detail::chunk_seed(seed, idx) };
+			for (std::size_t b = lo; b < hi; ++b)
+				detail::shuffle_batched(out.begin() + b * k, std::min(k, n - b * k), eng);
+		});
+		break;
+	}
+	case data_pattern::random_swaps: {
+		ascending();
+		using std::swap;
+		xoshiro256ss eng{ detail::chunk_seed(seed, 0) };
+		const auto swaps = static_cast<std::size_t>(std::clamp(opt.swap_fraction, 0., 1.) * static_cast<double>(n));
+		for (std::size_t i = 0; i < swaps; ++i)
+			swap(out[detail::bounded(n, eng)], out[detail::bounded(n, eng)]);
+		break;
+	}
+	}
+}
+
+/**
+ * @brief Resizes a contiguous container to `n` elements and fills it with a data pattern.
+ */
+template<typename Container>
+	requires requires(Container& c) { std::span{ c.data(), c.size() }; c.resize(std::size_t{}); }
+void fill_pattern(Container& c, std::size_t n, data_pattern p, const pattern_options& opt = {})
+{
+	c.resize(n);
+	fill_pattern(std::span{ c.data(), c.size() }, p, opt);
+}
+
+/**
+ * @brief Returns a setup callable for `benchmark` that hands out copies of a pattern.
+ *
+ * The pattern is generated once; every repetition gets a copy of the same input.
+ *
+ * @example
+ * @code
+ * std::vector<bench_result> results;
+ * for (auto p : all_data_patterns)
+ *     results.push_back(benchmark(std::string{ pattern_name(p) }, pattern_input<std::vector<int>>(1'000'000, p),
+ *         [](auto& v) { std::sort(v.begin(), v.end()); }, { .elements = 1'000'000 }));
+ * print_benchmarks(results);
+ * @endcode
+ */
+template<typename Container>
+[[nodiscard]] auto pattern_input(std::size_t n, data_pattern p, const pattern_options& opt = {})
+{
+	Container c;
+	fill_pattern(c, n, p, opt);
+	return [data = std::move(c)] { return data; };
 }
+
 //------------------------------------------------------
 //------------------------------------------------------
+
+/*   container footprint   */
+
 /**
- * @brief Determines if a given integer is a prime number.
+ * @brief The memory footprint and layout of a container, as measured by `measure_footprint`.
  *
- * This `constexpr` function checks whether a given integer is a prime number.
- * A prime number is a natural number greater than 1 that is not divisible by any
- * number other than 1 and itself. The function optimizes the check by initially
- * handling small divisors and then only testing odd numbers up to the square root of the input.
+ * The byte counts are the ones requested from the allocator; the bookkeeping of the heap
+ * (typically 8 to 16 bytes per allocation) comes on top of them.
+ */
+struct footprint_report {
+	std::string name;
+	std::size_t elements = 0;
+	std::size_t value_size = 0;   ///< `sizeof` the value type
+	std::size_t allocations = 0;  ///< allocations made while the container was filled
+	std::size_t bytes = 0;        ///< bytes in use after the fill
+	std::size_t peak_bytes = 0;   ///< bytes in use at the worst moment of the fill (e.g. a reallocation)
+	std::size_t cache_lines = 0;  ///< distinct cache lines holding the elements, as visited by one traversal
+	std::array<double, 4> gaps{}; ///< fractions of the address gaps between consecutive elements: < 64 B, < 4 KiB, < 1 MiB, larger
+
+	[[nodiscard]] double bytes_per_element() const noexcept
+	{
+		return elements ? static_cast<double>(bytes) / static_cast<double>(elements) : 0.;
+	}
+
+	/**
+	 * @brief The bytes per element beyond the element itself (node links, buckets, unused capacity).
+	 */
+	[[nodiscard]] double overhead_per_element() const noexcept
+	{
+		return elements ? bytes_per_element() - static_cast<double>(value_size) : 0.;
+	}
+
+	[[nodiscard]] double lines_per_element() const noexcept
+	{
+		return elements ? static_cast<double>(cache_lines) / static_cast<double>(elements) : 0.;
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& os, const footprint_report& r)
+{
+	const auto flags = os.flags();
+	const auto prec = os.precision();
+	os << std::left << std::setw(28) << r.name << std::right << std::setw(10) << r.elements << std::fixed << std::setprecision(1)
+		<< std::setw(11) << r.bytes_per_element() << std::setw(10) << r.overhead_per_element() << std::setw(10) << r.allocations
+		<< std::setw(11) << std::setprecision(3) << r.lines_per_element() << std::setprecision(1);
+	for (double g : r.gaps)
+		os << std::setw(8) << g * 100 << '%';
+	os.flags(flags);
+	os.precision(prec);
+	return os;
+}
+
+/**
+ * @brief Computes the layout figures of a filled container from the addresses of its elements.
  *
- * @param val The integer value to be checked for primality.
- * @return `true` if the input value is a prime number, `false` otherwise.
+ * @param name The name shown in the report.
+ * @param c The container.
+ * @param st The statistics of the allocator the container was filled with.
+ */
+template<typename Container>
+[[nodiscard]] footprint_report inspect_footprint(std::string name, const Container& c, const alloc_stats& st)
+{
+	using value_type = typename Container::value_type;
+	constexpr std::uintptr_t line = detail::cache_line_size;
+
+	footprint_report r;
+	r.name = std::move(name);
+	r.value_size = sizeof(value_type);
+	r.allocations = st.allocations;
+	r.bytes = st.current_bytes;
+	r.peak_bytes = st.peak_bytes;
+
+	std::vector<std::uintptr_t> lines;
+	std::array<std::size_t, 4> gaps{};
+	std::uintptr_t prev = 0;
+	for (const auto& elem : c) {
+		const auto addr = reinterpret_cast<std::uintptr_t>(std::addressof(elem));
+		for (std::uintptr_t l = addr / line; l <= (addr + sizeof(value_type) - 1) / line; ++l)
+			lines.push_back(l);
+		if (r.elements++) {
+			const std::uintptr_t gap = addr > prev ? addr - prev : prev - addr;
+			++gaps[gap < 64 ? 0 : gap < 4096 ? 1 : gap < (1u << 20) ? 2 : 3];
+		}
+		prev = addr;
+	}
+	std::sort(lines.begin(), lines.end());
+	r.cache_lines = static_cast<std::size_t>(std::unique(lines.begin(), lines.end()) - lines.begin());
+	if (r.elements > 1)
+		for (std::size_t i = 0; i < gaps.size(); ++i)
+			r.gaps[i] = static_cast<double>(gaps[i]) / static_cast<double>(r.elements - 1);
+	return r;
+}
+
+/**
+ * @brief Fills a container that uses `counting_allocator` with `rfill` and reports its footprint.
  *
- * @note The function is marked as `noexcept`, indicating it does not throw exceptions,
- *       and as `[[nodiscard]]`, which encourages the caller to use the return value.
+ * @tparam Container A container whose allocator is a `counting_allocator`, e.g.
+ *         `std::set<int, std::less<int>, counting_allocator<int>>`.
+ * @param name The name shown in the report.
+ * @param n The number of elements.
+ * @param frand The random function passed to `rfill`.
  *
  * @example
  * @code
- * constexpr bool result = isprime(29); // result will be true
+ * std::vector<footprint_report> reports;
+ * reports.push_back(measure_footprint<std::vector<int, counting_allocator<int>>>("vector", 1'000'000, Irand{ 0, 1'000'000 }));
+ * reports.push_back(measure_footprint<std::list<int, counting_allocator<int>>>("list", 1'000'000, Irand{ 0, 1'000'000 }));
+ * reports.push_back(measure_footprint<std::set<int, std::less<int>, counting_allocator<int>>>("set", 1'000'000, Irand{ 0, 10'000'000 }));
+ * print_footprints(reports);
  * @endcode
  */
-constexpr [[nodiscard]] bool isprime(int val) noexcept
+template<typename Container, typename Random>
+	requires std::is_constructible_v<typename Container::allocator_type, alloc_stats&>
+[[nodiscard]] footprint_report measure_footprint(std::string name, std::size_t n, Random frand)
 {
-	if (val < 2)
-		return false;
+	alloc_stats st;
+	Container c{ typename Container::allocator_type{ st } };
+	rfill(c, n, frand);
+	return inspect_footprint(std::move(name), c, st);
+}
 
-	if (val % 2 == 0)
-		return val == 2;
+/**
+ * @brief Prints footprint reports as a comparison table framed by dash lines.
+ *
+ * @param reports The reports to be printed.
+ * @param os The output stream. The default is `std::cout`.
+ */
+inline void print_footprints(const std::vector<footprint_report>& reports, std::ostream& os = std::cout)
+{
+	const auto flags = os.flags();
+	os << std::left << std::setw(28) << "container" << std::right << std::setw(10) << "elements" << std::setw(11) << "bytes/elem"
+		<< std::setw(10) << "overhead" << std::setw(10) << "allocs" << std::setw(11) << "lines/elem"
+		<< std::setw(9) << "<64B" << std::setw(9) << "<4K" << std::setw(9) << "<1M" << std::setw(9) << ">=1M" << dash_line;
+	os.flags(flags);
+	print(reports, "\n", os);
+}
 
-	if (val % 3 == 0)
-		return val == 3;
+//------------------------------------------------------
+//------------------------------------------------------
 
-	if (val % 5 == 0)
-		return val == 5;
+/*   file checksums and comparison   */
 
-	for (int k = 7; k * k <= val; k += 2)
-		if (val % k == 0)
-			return false;
+namespace detail {
 
-	return true;
+	inline constexpr std::uint32_t crc32c_poly = 0x82F63B78u; //Castagnoli, reflected
+
+	struct crc32c_tables {
+		std::uint32_t t[8][256];
+
+		constexpr crc32c_tables() : t{}
+		{
+			for (std::uint32_t i = 0; i < 256; ++i) {
+				std::uint32_t crc = i;
+				for (int k = 0; k < 8; ++k)
+					crc = crc & 1 ? (crc >> 1) ^ crc32c_poly : crc >> 1;
+				t[0][i] = crc;
+			}
+			for (std::uint32_t i = 0; i < 256; ++i)
+				for (int s = 1; s < 8; ++s)
+					t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+		}
+	};
+
+	inline constexpr crc32c_tables crc32c_table{};
+
+	/**
+	 * @brief Portable CRC-32C, slicing by 8: one table lookup per byte, eight bytes per step.
+	 */
+	[[nodiscard]] inline std::uint32_t crc32c_sw(std::uint32_t crc, const unsigned char* p, std::size_t n) noexcept
+	{
+		const auto& t = crc32c_table.t;
+		while (n >= 8) {
+			std::uint64_t w;
+			std::memcpy(&w, p, 8);
+			if constexpr (std::endian::native == std::endian::big)
+				w = ((w & 0xFF) << 56) | ((w & 0xFF00) << 40) | ((w & 0xFF0000) << 24) | ((w & 0xFF000000) << 8)
+				| ((w >> 8) & 0xFF000000) | ((w >> 24) & 0xFF0000) | ((w >> 40) & 0xFF00) | (w >> 56);
+			w ^= crc;
+			crc = t[7][w & 0xFF] ^ t[6][(w >> 8) & 0xFF] ^ t[5][(w >> 16) & 0xFF] ^ t[4][(w >> 24) & 0xFF]
+				^ t[3][(w >> 32) & 0xFF] ^ t[2][(w >> 40) & 0xFF] ^ t[1][(w >> 48) & 0xFF] ^ t[0][w >> 56];
+			p += 8;
+			n -= 8;
+		}
+		while (n--)
+			crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+		return crc;
+	}
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NUTILITY_CRC32C_X86 1
+	__attribute__((target("sse4.2"))) inline std::uint32_t crc32c_hw(std::uint32_t crc, const unsigned char* p, std::size_t n) noexcept
+	{
+#if defined(__x86_64__)
+		std::uint64_t c = crc;
+		for (; n >= 8; p += 8, n -= 8) {
+			std::uint64_t w;
+			std::memcpy(&w, p, 8);
+			c = __builtin_ia32_crc32di(c, w);
+		}
+		crc = static_cast<std::uint32_t>(c);
+#endif
+		for (; n >= 4; p += 4, n -= 4) {
+			std::uint32_t w;
+			std::memcpy(&w, p, 4);
+			crc = __builtin_ia32_crc32si(crc, w);
+		}
+		while (n--)
+			crc = __builtin_ia32_crc32qi(crc, *p++);
+		return crc;
+	}
+
+	[[nodiscard]] inline bool crc32c_hw_available() noexcept
+	{
+		static const bool available = __builtin_cpu_supports("sse4.2");
+		return available;
+	}
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define NUTILITY_CRC32C_X86 1
+	inline std::uint32_t crc32c_hw(std::uint32_t crc, const unsigned char* p, std::size_t n) noexcept
+	{
+		std::uint64_t c = crc;
+		for (; n >= 8; p += 8, n -= 8) {
+			std::uint64_t w;
+			std::memcpy(&w, p, 8);
+			c = _mm_crc32_u64(c, w);
+		}
+		crc = static_cast<std::uint32_t>(c);
+		while (n--)
+			crc = _mm_crc32_u8(crc, *p++);
+		return crc;
+	}
+
+	[[nodiscard]] inline bool crc32c_hw_available() noexcept
+	{
+		static const bool available = [] {
+			int info[4];
+			__cpuid(info, 1);
+			return (info[2] & (1 << 20)) != 0;
+		}();
+		return available;
+	}
+#endif
+
+	/**
+	 * @brief Multiplies two polynomials modulo the CRC polynomial (reflected bit order).
+	 */
+	[[nodiscard]] constexpr std::uint32_t crc32c_multmodp(std::uint32_t a, std::uint32_t b) noexcept
+	{
+		std::uint32_t m = 1u << 31, p = 0;
+		for (;;) {
+			if (a & m) {
+				p ^= b;
+				if ((a & (m - 1)) == 0)
+					break;
+			}
+			m >>= 1;
+			b = b & 1 ? (b >> 1) ^ crc32c_poly : b >> 1;
+		}
+		return p;
+	}
+
+	/**
+	 * @brief x^(8 * len) modulo the CRC polynomial, by repeated squaring.
+	 */
+	[[nodiscard]] constexpr std::uint32_t crc32c_shift(std::uint64_t len) noexcept
+	{
+		std::uint32_t p = 1u << 31; //x^0
+		std::uint32_t x2n = 1u << 23; //x^8, then squared at every step
+		while (len) {
+			if (len & 1)
+				p = crc32c_multmodp(x2n, p);
+			len >>= 1;
+			x2n = crc32c_multmodp(x2n, x2n);
+		}
+		return p;
+	}
+
+	inline constexpr std::size_t file_chunk_size = std::size_t{ 4 } << 20;
+}
+
+/**
+ * @brief Computes the CRC-32C (Castagnoli) checksum of a block of memory.
+ *
+ * On x86 processors with SSE4.2 the `crc32` instruction handles eight bytes per step (selected at
+ * run time); elsewhere a slicing-by-8 table is used. The result equals that of other CRC-32C
+ * implementations (e.g. iSCSI, ext4, `crc32c` tools); passing a previous result as `crc`
+ * continues the checksum over consecutive blocks.
+ *
+ * @param data The first byte of the block.
+ * @param n The size of the block.
+ * @param crc The checksum of the preceding data, 0 at the start.
+ */
+[[nodiscard]] inline std::uint32_t crc32c(const void* data, std::size_t n, std::uint32_t crc = 0) noexcept
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	crc = ~crc;
+#if defined(NUTILITY_CRC32C_X86)
+	if (detail::crc32c_hw_available())
+		return ~detail::crc32c_hw(crc, p, n);
+#elif defined(__ARM_FEATURE_CRC32)
+	for (; n >= 8; p += 8, n -= 8) {
+		std::uint64_t w;
+		std::memcpy(&w, p, 8);
+		crc = __crc32cd(crc, w);
+	}
+	while (n--)
+		crc = __crc32cb(crc, *p++);
+	return ~crc;
+#endif
+	return ~detail::crc32c_sw(crc, p, n);
+}
+
+/**
+ * @brief Combines the checksums of two consecutive blocks: the result is the checksum of `A` followed by `B`.
+ *
+ * @param crc_a The checksum of the first block.
+ * @param crc_b The checksum of the second block.
+ * @param len_b The size of the second block in bytes.
+ */
+[[nodiscard]] constexpr std::uint32_t crc32c_combine(std::uint32_t crc_a, std::uint32_t crc_b, std::uint64_t len_b) noexcept
+{
+	return detail::crc32c_multmodp(detail::crc32c_shift(len_b), crc_a) ^ crc_b;
 }
 
 //------------------------------------------------------
 //------------------------------------------------------
 /**
- * @brief Calculates the number of digits in an integer.
+ * @brief Computes the CRC-32C checksum of a file with several threads.
  *
- * This `constexpr` function determines the number of digits in the given integer `val`.
- * It handles both positive and negative integers, as well as zero. For a value of zero,
- * the function returns 1, since zero is considered to have one digit.
+ * The file is memory mapped (see `mapped_file`) and cut into chunks of 4 MiB, which the threads
+ * checksum independently; the chunk checksums are combined in order, so the result does not
+ * depend on the number of threads and equals the CRC-32C of the whole file.
  *
- * @param val The integer whose digits are to be counted.
- * @return An `int` representing the number of digits in the input integer.
+ * @param filename The name of the file.
+ * @param threads The number of threads.
+ * @return The CRC-32C of the content of the file.
  *
- * @note The function is marked as `[[nodiscard]]`, indicating that the caller should not ignore the returned value.
+ * @throws std::runtime_error If the file cannot be opened.
  *
  * @example
  * @code
- * int num_digits = ndigit(12345); // Returns 5
- * int num_digits_negative = ndigit(-987); // Returns 3
- * int num_digits_zero = ndigit(0); // Returns 1
- * std::cout << "Digits: " << num_digits << std::endl;
+ * save_fixture("keys.bin", keys);
+ * const auto sum = hash_file("keys.bin");
  * @endcode
  */
-constexpr [[nodiscard]] int ndigit(int val)
+[[nodiscard]] inline std::uint32_t hash_file(const std::string& filename, unsigned threads = std::thread::hardware_concurrency())
 {
-	if (val == 0)
-		return 1;
+	const auto file = map_binary_file(filename);
+	const auto data = file.bytes();
+	const std::size_t chunks = (data.size() + detail::file_chunk_size - 1) / detail::file_chunk_size;
+	if (chunks <= 1)
+		return crc32c(data.data(), data.size());
 
-	int digit_count = 0;
+	std::vector<std::uint32_t> sums(chunks);
+	detail::run_chunks(0, chunks, std::max(1u, threads), [&](unsigned, std::size_t lo, std::size_t hi) {
+		for (std::size_t i = lo; i < hi; ++i) {
+			const std::size_t offset = i * detail::file_chunk_size;
+			sums[i] = crc32c(data.data() + offset, std::min(detail::file_chunk_size, data.size() - offset));
+		}
+	});
 
-	while (val != 0) {
-		val /= 10;
-		++digit_count;
-	}
-
-	return digit_count;
+	std::uint32_t crc = sums[0];
+	for (std::size_t i = 1; i < chunks; ++i)
+		crc = crc32c_combine(crc, sums[i], std::min(detail::file_chunk_size, data.size() - i * detail::file_chunk_size));
+	return crc;
 }
-//------------------------------------------------------
-//------------------------------------------------------
+
 /**
- * @brief An ostream manipulator that inserts a line of dash characters into the stream.
+ * @brief Returns `true` if two files have exactly the same content.
  *
- * The `dash_line` manipulator outputs a line of dash characters, followed by newline characters,
- * to the given output stream. It is commonly used to create a visual separation or underline
- * in the output for better readability.
+ * The sizes are compared first. Otherwise both files are memory mapped and compared with `memcmp`
+ * in blocks of 1 MiB by several threads; all threads stop as soon as one of them finds a difference.
  *
- * @param os The output stream to which the line of dash characters is inserted.
- * @return A reference to the modified output stream.
+ * @param filename_a The name of the first file.
+ * @param filename_b The name of the second file.
+ * @param threads The number of threads.
  *
- * @example
- * @code
- * std::cout << "Header" << dash_line << "Content" << std::endl;
- * @endcode
- * This will produce:
- * @code
- * Header
- * -----------------------------------------------------------------------------
- * Content
- * @endcode
+ * @throws std::runtime_error If a file cannot be opened.
  */
-inline std::ostream& dash_line(std::ostream& os)
+[[nodiscard]] inline bool files_equal(const std::string& filename_a, const std::string& filename_b, unsigned threads = std::thread::hardware_concurrency())
 {
-	return os << "\n-----------------------------------------------------------------------------\n";
+	const auto file_a = map_binary_file(filename_a);
+	const auto file_b = map_binary_file(filename_b);
+	if (file_a.size() != file_b.size())
+		return false;
+
+	constexpr std::size_t block = std::size_t{ 1 } << 20;
+	const std::size_t size = file_a.size();
+	const std::size_t blocks = (size + block - 1) / block;
+	std::atomic<bool> differ{ false };
+	detail::run_chunks(0, blocks, std::max(1u, threads), [&](unsigned, std::size_t lo, std::size_t hi) {
+		for (std::size_t i = lo; i < hi && !differ.load(std::memory_order_relaxed); ++i) {
+			const std::size_t offset = i * block;
+			if (std::memcmp(file_a.data() + offset, file_b.data() + offset, std::min(block, size - offset)) != 0)
+				differ.store(true, std::memory_order_relaxed);
+		}
+	});
+	return !differ.load();
 }
+
 //------------------------------------------------------
 //------------------------------------------------------
 
-/*   file operations   */
+/*   tracing   */
 
-inline [[nodiscard]] std::ifstream open_text_file(const std::string& filename)
-{
-	std::ifstream ifs{ filename };
-	if (!ifs) {
-		throw std::runtime_error{ filename + " : cannot be opened!\n" };
+/**
+ * @brief One recorded trace event: a phase with a duration or, with `duration_ns == -1`, an instant.
+ */
+struct trace_event {
+	const char* name;          ///< must refer to static storage, e.g. a string literal
+	std::int64_t start_ns;     ///< since the start of the trace clock
+	std::int64_t duration_ns;
+};
+
+namespace detail {
+
+	inline constexpr std::size_t trace_capacity = std::size_t{ 1 } << 16; //events per thread, the oldest are overwritten
+
+	/**
+	 * @brief The ring buffer of one thread; only the owning thread writes to it.
+	 */
+	struct trace_buffer {
+		explicit trace_buffer(std::uint32_t id) : tid{ id }, events(trace_capacity) {}
+
+		void record(const char* name, std::int64_t start, std::int64_t duration) noexcept
+		{
+			const std::uint64_t idx = head.load(std::memory_order_relaxed);
+			events[idx & (trace_capacity - 1)] = trace_event{ name, start, duration };
+			head.store(idx + 1, std::memory_order_release);
+		}
+
+		std::uint32_t tid;
+		std::atomic<std::uint64_t> head{ 0 };
+		std::vector<trace_event> events;
+	};
+
+	struct trace_registry {
+		/**
+		 * @brief Hands a buffer to a thread, preferably one left by an exited thread.
+		 */
+		[[nodiscard]] trace_buffer* acquire()
+		{
+			std::lock_guard lock{ mtx };
+			if (!free_buffers.empty()) {
+				trace_buffer* p = free_buffers.back();
+				free_buffers.pop_back();
+				return p;
+			}
+			buffers.push_back(std::make_unique<trace_buffer>(static_cast<std::uint32_t>(buffers.size() + 1)));
+			return buffers.back().get();
+		}
+
+		void release(trace_buffer* p)
+		{
+			std::lock_guard lock{ mtx };
+			free_buffers.push_back(p);
+		}
+
+		std::mutex mtx;
+		std::vector<std::unique_ptr<trace_buffer>> buffers; //events of exited threads stay until reused
+		std::vector<trace_buffer*> free_buffers;
+		std::atomic<bool> enabled{ true };
+		const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+	};
+
+	[[nodiscard]] inline trace_registry& traces()
+	{
+		static trace_registry reg;
+		return reg;
 	}
 
-	return ifs;
+	//returns the buffer of the thread to the registry when the thread exits
+	struct trace_buffer_lease {
+		trace_buffer_lease() = default;
+		trace_buffer_lease(const trace_buffer_lease&) = delete;
+		trace_buffer_lease& operator=(const trace_buffer_lease&) = delete;
+		~trace_buffer_lease()
+		{
+			if (buf)
+				traces().release(buf);
+		}
+
+		trace_buffer* buf = nullptr;
+	};
+
+	/**
+	 * @brief Returns the buffer of the calling thread, acquiring it on first use.
+	 *
+	 * @return `nullptr` if no buffer could be allocated; the event is then dropped.
+	 */
+	[[nodiscard]] inline trace_buffer* thread_trace_buffer() noexcept
+	{
+		thread_local trace_buffer_lease lease;
+		if (!lease.buf) {
+			try {
+				lease.buf = traces().acquire();
+			}
+			catch (...) {
+				return nullptr;
+			}
+		}
+		return lease.buf;
+	}
+
+	[[nodiscard]] inline std::int64_t trace_now() noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traces().epoch).count();
+	}
+
+	inline void trace_record(const char* name, std::int64_t start, std::int64_t duration) noexcept
+	{
+		if (trace_buffer* buf = thread_trace_buffer())
+			buf->record(name, start, duration);
+	}
+
+	//the start of a phase: the buffer is acquired first, so its allocation is not part of the phase
+	[[nodiscard]] inline std::int64_t trace_start() noexcept
+	{
+		if (traces().enabled.load(std::memory_order_relaxed))
+			(void)thread_trace_buffer();
+		return trace_now();
+	}
+
+	inline void append_json_string(std::string& out, std::string_view sv)
+	{
+		out += '"';
+		for (char c : sv) {
+			if (c == '"' || c == '\\') {
+				out += '\\';
+				out += c;
+			}
+			else if (static_cast<unsigned char>(c) < 0x20) {
+				char buf[8];
+				std::snprintf(buf, sizeof buf, "\\u%04x", static_cast<unsigned>(c));
+				out += buf;
+			}
+			else
+				out += c;
+		}
+		out += '"';
+	}
+
+	//nanoseconds as microseconds with three decimals, as Chrome trace timestamps are in microseconds
+	inline void append_trace_time(std::string& out, std::int64_t ns)
+	{
+		char buf[32];
+		const auto res = std::to_chars(buf, buf + sizeof buf, static_cast<double>(ns) / 1000., std::chars_format::fixed, 3);
+		out.append(buf, res.ptr);
+	}
 }
-//------------------------------------------------------
-//------------------------------------------------------
+
 /**
- * @brief Creates a text file and returns an std::ofstream object for it.
- *
- * This function attempts to create a text file with the specified name and
- * returns an `std::ofstream` object that can be used to write to the file.
- * If the file cannot be created, a `std::runtime_error` is thrown.
- *
- * @param filename The name of the file to be created.
- *
- * @return An `std::ofstream` object that controls the newly created text file.
- *
- * @throws std::runtime_error If the file cannot be created.
- *
- * @note The file is opened in text mode by default. No special mode flags
- * are set.
+ * @brief Turns the recording of trace events on or off (it is on by default).
  *
- * @warning Ensure that the file name is valid and that you have appropriate
- * permissions to create files in the specified directory.
+ * While recording is off, `scoped_timer` and `trace_instant` only test a flag.
  */
-inline [[nodiscard]] std::ofstream create_text_file(const std::string& filename)
+inline void enable_tracing(bool on) noexcept
 {
-	std::ofstream ofs{ filename };
-
-	if (!ofs) {
-		throw std::runtime_error{ filename + ": cannot be created!\n" };
-	}
-
-	return ofs;
+	detail::traces().enabled.store(on, std::memory_order_relaxed);
 }
 
-//------------------------------------------------------
-//------------------------------------------------------
-inline [[nodiscard]] std::ifstream open_binary_file(const std::string& filename)
+/**
+ * @brief Records an instant event (a marker without duration) on the calling thread's timeline.
+ *
+ * @param name The name of the event; it must refer to static storage, e.g. a string literal.
+ */
+inline void trace_instant(const char* name) noexcept
 {
-	std::ifstream ifs{ filename, std::ios::binary };
-	if (!ifs) {
-		throw std::runtime_error{ filename + " : cannot be opened!\n" };
-	}
-
-	return ifs;
+	if (detail::traces().enabled.load(std::memory_order_relaxed))
+		detail::trace_record(name, detail::trace_now(), -1);
 }
+
 //------------------------------------------------------
 //------------------------------------------------------
 /**
- * @brief Creates a binary file and returns an std::ofstream object for it.
- *
- * This function attempts to create a binary file with the specified name and
- * returns an `std::ofstream` object that can be used to write to the file.
- * If the file cannot be created, a `std::runtime_error` is thrown.
- *
- * @param filename The name of the file to be created.
- *
- * @return An `std::ofstream` object that controls the newly created binary file.
- *
- * @throws std::runtime_error If the file cannot be created.
+ * @class scoped_timer
+ * @brief Measures the lifetime of a scope and records it as a trace event.
  *
- * @note The file is opened in binary mode (`std::ios::binary`), so no
- * conversions or translations of the data will occur.
+ * Recording writes one entry into the calling thread's ring buffer without any lock, so it costs
+ * two clock reads and a few stores; the timers can stay in production code. Every thread keeps
+ * its last 65536 events. A thread that exits leaves its buffer (and its track in the trace) to the
+ * next new thread, so short-lived workers such as those of `parallel_rfill` reuse the same memory.
+ * The first timer of a thread acquires the buffer before its clock starts; if the buffer cannot be
+ * allocated, the events of that thread are dropped. If an output stream is given, the elapsed
+ * time is printed to it as well.
  *
- * @warning Ensure that the file name is valid and that you have appropriate
- * permissions to create files in the specified directory.
+ * @example
+ * @code
+ * std::vector<int> ivec;
+ * {
+ *     scoped_timer t{ "generate" };
+ *     rfill(ivec, 10'000'000, Irand{ 0, 1'000'000 });
+ * }
+ * {
+ *     scoped_timer t{ "sort", std::cout }; // also prints "sort: ... ms"
+ *     std::sort(ivec.begin(), ivec.end());
+ * }
+ * dump_trace("trace.json"); // open with chrome://tracing or ui.perfetto.dev
+ * @endcode
  */
-inline [[nodiscard]] std::ofstream create_binary_file(const std::string& filename)
-{
-	std::ofstream ofs{ filename, std::ios::binary };
 
-	if (!ofs) {
-		throw std::runtime_error{ filename + " : cannot be created!\n" };
+class scoped_timer {
+public:
+	/**
+	 * @param name The name of the event; it must refer to static storage, e.g. a string literal.
+	 */
+	explicit scoped_timer(const char* name) noexcept : m_name{ name }, m_start{ detail::trace_start() } {}
+
+	scoped_timer(const char* name, std::ostream& os) noexcept : m_name{ name }, m_os{ &os }, m_start{ detail::trace_start() } {}
+
+	scoped_timer(const scoped_timer&) = delete;
+	scoped_timer& operator=(const scoped_timer&) = delete;
+
+	~scoped_timer()
+	{
+		const std::int64_t duration = detail::trace_now() - m_start;
+		if (detail::traces().enabled.load(std::memory_order_relaxed))
+			detail::trace_record(m_name, m_start, duration);
+		if (m_os)
+			*m_os << m_name << ": " << static_cast<double>(duration) / 1e6 << " ms\n";
 	}
 
-	return ofs;
-}
+	/**
+	 * @brief Returns the nanoseconds elapsed since the construction.
+	 */
+	[[nodiscard]] std::int64_t elapsed_ns() const noexcept
+	{
+		return detail::trace_now() - m_start;
+	}
+
+private:
+	const char* m_name;
+	std::ostream* m_os = nullptr;
+	std::int64_t m_start;
+};
 
 //------------------------------------------------------
 //------------------------------------------------------
 /**
- * @brief Reads the entire content of a text file into a std::string.
- *
- * This function opens the specified text file using the `open_text_file` function,
- * reads its content, and returns it as a `std::string`.
+ * @brief Writes the recorded events of all threads to a file in the Chrome trace event format.
  *
- * @param filename The name of the file to be read.
- *
- * @return A `std::string` containing the content of the file.
- *
- * @throws std::ifstream::failure If the file could not be opened or read.
+ * The file can be opened with `chrome://tracing` or https://ui.perfetto.dev; every thread is shown
+ * as a separate track. The threads being traced should be idle while the events are collected.
  *
- * @note The file is opened in text mode. Ensure that the file exists and is accessible.
+ * @param filename The name of the file to be created with `create_text_file`.
  *
- * @warning This function does not handle file encoding issues or very large files
- * which may require more efficient reading methods.
+ * @throws std::runtime_error If the file cannot be created.
  */
-inline [[nodiscard]] std::string get_str_from_file(const std::string& filename)
+inline void dump_trace(const std::string& filename)
 {
-	std::ifstream ifs{ open_text_file(filename) };
-	std::ostringstream oss;
-	oss << ifs.rdbuf();
+	std::string json = "{\"traceEvents\":[";
+	bool first = true;
+	{
+		auto& reg = detail::traces();
+		std::lock_guard lock{ reg.mtx };
+		for (const auto& buf : reg.buffers) {
+			const std::uint64_t head = buf->head.load(std::memory_order_acquire);
+			const std::uint64_t begin = head > detail::trace_capacity ? head - detail::trace_capacity : 0;
+			for (std::uint64_t i = begin; i < head; ++i) {
+				const trace_event& ev = buf->events[i & (detail::trace_capacity - 1)];
+				json += first ? "\n{\"name\":" : ",\n{\"name\":";
+				first = false;
+				detail::append_json_string(json, ev.name);
+				json += ev.duration_ns < 0 ? ",\"ph\":\"i\",\"s\":\"t\",\"ts\":" : ",\"ph\":\"X\",\"ts\":";
+				detail::append_trace_time(json, ev.start_ns);
+				if (ev.duration_ns >= 0) {
+					json += ",\"dur\":";
+					detail::append_trace_time(json, ev.duration_ns);
+				}
+				json += ",\"pid\":1,\"tid\":";
+				json += std::to_string(buf->tid);
+				json += '}';
+			}
+		}
+	}
+	json += "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+	auto ofs = create_text_file(filename);
+	ofs.write(json.data(), static_cast<std::streamsize>(json.size()));
+	if (!ofs)
+		throw std::runtime_error{ filename + " : cannot be written!\n" };
+}
 
-	return oss.str();
+/**
+ * @brief Discards the recorded events of all threads. The threads being traced should be idle.
+ */
+inline void clear_trace()
+{
+	auto& reg = detail::traces();
+	std::lock_guard lock{ reg.mtx };
+	for (const auto& buf : reg.buffers)
+		buf->head.store(0, std::memory_order_release);
 }